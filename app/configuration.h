@@ -40,6 +40,9 @@ class configuration {
                 void strong_separator( PartitionConfig & config );
                 void eco_separator( PartitionConfig & config );
                 void fast_separator( PartitionConfig & config );
+                void eco_separator_parallel( PartitionConfig & config );
+                void fast_separator_parallel( PartitionConfig & config );
+                void parallel_separator( PartitionConfig & config );
 
                 void standard( PartitionConfig & config );
                 void standardsnw( PartitionConfig & config );
@@ -322,6 +325,28 @@ inline void configuration::fast_separator( PartitionConfig & partition_config )
         partition_config.global_cycle_iterations = 1;
 }
 
+inline void configuration::eco_separator_parallel( PartitionConfig & partition_config ) {
+        eco_separator(partition_config);
+        parallel_separator(partition_config);
+}
+
+inline void configuration::fast_separator_parallel( PartitionConfig & partition_config ) {
+        fast_separator(partition_config);
+        parallel_separator(partition_config);
+}
+
+inline void configuration::parallel_separator( PartitionConfig & partition_config ) {
+        // coarsening
+        partition_config.matching_type            = CLUSTER_COARSENING;
+        partition_config.ensemble_clusterings     = false;
+        partition_config.block_size_unit          = BlockSizeUnit::EDGES;
+        partition_config.parallel_coarsening_lp   = true;
+        partition_config.fast_contract_clustering = true;
+
+        // initial separators and label propagation refinement of the separator
+        partition_config.parallel_node_separator  = true;
+}
+
 
 
 inline void configuration::standard( PartitionConfig & partition_config ) {
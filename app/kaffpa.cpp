@@ -23,6 +23,7 @@
 #include <argtable2.h>
 #include <iostream>
 #include <math.h>
+#include <numeric>
 #include <regex.h>
 #include <sstream>
 #include <stdio.h>
@@ -32,10 +33,13 @@
 #include "data_structure/graph_access.h"
 #include "data_structure/parallel/graph_utils.h"
 #include "data_structure/parallel/thread_pool.h"
+#include "data_structure/parallel/time.h"
 #include "graph_io.h"
 #include "macros_assertions.h"
 #include "parse_parameters.h"
 #include "partition/graph_partitioner.h"
+#include "partition/incremental/incremental_repartitioning.h"
+#include "partition/mapping/process_mapping.h"
 #include "partition/partition_config.h"
 #include "partition/uncoarsening/refinement/cycle_improvements/cycle_refinement.h"
 #include "quality_metrics.h"
@@ -118,8 +122,48 @@ int main(int argn, char **argv) {
         graph_access G;     
         ALWAYS_ASSERT(partition_config.main_core == 0);
 
+        if (partition_config.enable_mapping) {
+                PartitionID num_pes = 1;
+                for (int group_size : partition_config.group_sizes) {
+                        num_pes *= group_size;
+                }
+                if (partition_config.group_sizes.empty()
+                    || partition_config.group_sizes.size() != partition_config.distances.size()
+                    || num_pes != partition_config.k) {
+                        std::cerr << "--enable_mapping requires a hierarchy with k PEs and a distance for every level" << std::endl;
+                        exit(1);
+                }
+        }
+
         timer t;
-        if (!partition_config.shuffle_graph && !partition_config.sort_edges) {
+        std::vector<NodeID> touched_nodes;
+        if (!partition_config.edge_delta.empty()) {
+                if (partition_config.input_partition.empty()) {
+                        std::cerr << "--edge_delta requires --input_partition" << std::endl;
+                        exit(1);
+                }
+                graph_access tmp_G;
+                graph_io::readGraphWeighted(tmp_G, graph_filename);
+                graph_io::readPartition(tmp_G, partition_config.input_partition);
+                // the highest blocks may be empty, so only the block ids are checked against k
+                forall_nodes(tmp_G, node) {
+                        if (tmp_G.getPartitionIndex(node) >= partition_config.k) {
+                                std::cerr << "--input_partition has block " << tmp_G.getPartitionIndex(node)
+                                          << " but --k is " << partition_config.k << std::endl;
+                                exit(1);
+                        }
+                } endfor
+                tmp_G.set_partition_count(partition_config.k);
+
+                graph_delta delta;
+                if (graph_io::readGraphDelta(delta, partition_config.edge_delta)) {
+                        exit(1);
+                }
+                parallel::incremental_repartitioning repartitioning;
+                if (repartitioning.apply_delta(delta, tmp_G, G, touched_nodes)) {
+                        exit(1);
+                }
+        } else if (!partition_config.shuffle_graph && !partition_config.sort_edges) {
                 graph_io::readGraphWeighted(G, graph_filename);
                 //double avg;
                 //double med;
@@ -140,7 +184,9 @@ int main(int argn, char **argv) {
                 }
         }
         std::cout << "io time: " << t.elapsed()  << std::endl;
-        G.set_partition_count(partition_config.k);
+        if (partition_config.edge_delta.empty()) {
+                G.set_partition_count(partition_config.k);
+        }
  
         balance_configuration bc;
         bc.configurate_balance( partition_config, G);
@@ -150,7 +196,9 @@ int main(int argn, char **argv) {
         std::vector<PartitionID> input_partition;
         if (partition_config.input_partition != "") {
                 std::cout <<  "reading input partition" << std::endl;
-                graph_io::readPartition(G, partition_config.input_partition);
+                if (partition_config.edge_delta.empty()) {
+                        graph_io::readPartition(G, partition_config.input_partition);
+                }
                 partition_config.graph_allready_partitioned = true;
                 partition_config.only_first_level = true;
                 partition_config.mh_no_mh = false;
@@ -236,13 +284,49 @@ int main(int argn, char **argv) {
         graph_partitioner partitioner;
 
         std::cout <<  "performing partitioning!"  << std::endl;
-        if(partition_config.time_limit == 0) {
+        if (!partition_config.batch_k.empty()) {
+                std::vector<std::vector<PartitionID>> partitions;
+                partitioner.perform_batch_partitioning(partition_config, G, partition_config.batch_k, partitions);
+
+                ofs.close();
+                std::cout.rdbuf(backup);
+                std::cout <<  "time spent for partitioning " << t.elapsed()  << std::endl;
+                for (size_t i = 0; i < partitions.size(); ++i) {
+                        PartitionID k = partition_config.batch_k[i];
+                        forall_nodes(G, node) {
+                                G.setPartitionIndex(node, partitions[i][node]);
+                        } endfor
+                        G.set_partition_count(k);
+
+                        partition_metrics metrics = qm.parallel_metrics(G);
+                        std::cout << "k\t" << k << "\tcut\t" << metrics.edge_cut << "\tbalance\t" << metrics.balance << std::endl;
+                        if (!partition_config.filename_output.empty()) {
+                                graph_io::writePartition(G, partition_config.filename_output + ".k" + std::to_string(k));
+                        }
+                }
+                return 0;
+        }
+
+        if (!partition_config.edge_delta.empty()) {
+                // the partition of the changed graph is only refined around the changes
+                parallel::incremental_repartitioning repartitioning;
+                repartitioning.perform_refinement(partition_config, G, touched_nodes);
+        } else if(partition_config.time_limit == 0) {
                 partitioner.perform_partitioning(partition_config, G);
         } else {
-                PartitionID* map = new PartitionID[G.number_of_nodes()];
-                EdgeWeight best_cut = std::numeric_limits<EdgeWeight>::max();
-                while(t.elapsed() < partition_config.time_limit) {
-                        partition_config.graph_allready_partitioned = false;
+                // all phases stop at the deadline and keep their best partition, the time left after
+                // the first run is spent on v-cycles which start from the best partition found so far
+                partition_config.deadline = parallel::steady_time() + partition_config.time_limit;
+                partitioner.perform_partitioning(partition_config, G);
+
+                std::vector<PartitionID> map(G.number_of_nodes());
+                forall_nodes(G, node) {
+                        map[node] = G.getPartitionIndex(node);
+                } endfor
+                EdgeWeight best_cut = qm.edge_cut(G);
+
+                while(!parallel::deadline_reached(partition_config.deadline)) {
+                        partition_config.graph_allready_partitioned = true;
                         partitioner.perform_partitioning(partition_config, G);
                         EdgeWeight cut = qm.edge_cut(G);
                         if(cut < best_cut) {
@@ -250,12 +334,12 @@ int main(int argn, char **argv) {
                                 forall_nodes(G, node) {
                                         map[node] = G.getPartitionIndex(node);
                                 } endfor
+                        } else {
+                                forall_nodes(G, node) {
+                                        G.setPartitionIndex(node, map[node]);
+                                } endfor
                         }
                 }
-
-                forall_nodes(G, node) {
-                        G.setPartitionIndex(node, map[node]);
-                } endfor
         }
 
         if( partition_config.kaffpa_perfectly_balance ) {
@@ -265,6 +349,7 @@ int main(int argn, char **argv) {
                 complete_boundary boundary(&G);
                 boundary.build();
 
+                partition_config.parallel_cycle_refinement = partition_config.num_threads > 1;
                 cycle_refinement cr;
                 cr.perform_refinement(partition_config, G, boundary);
         }
@@ -275,16 +360,51 @@ int main(int argn, char **argv) {
         std::cout <<  "time spent for partitioning " << t.elapsed()  << std::endl;
        
         // output some information about the partition that we have computed
-        Gain cut = qm.edge_cut(G);
+        partition_metrics metrics = qm.parallel_metrics(G);
+        Gain cut = metrics.edge_cut;
         std::cout << "cut \t\t"         << cut                            << std::endl;
         if (partition_config.input_partition != "") {
                 std::cout << "input partition cut\t" << input_partition_cut << std::endl;
                 std::cout << "improvement\t" << input_partition_cut - cut << std::endl;
+
+                NodeID migrated_nodes = 0;
+                forall_nodes(G, node) {
+                        if (G.getPartitionIndex(node) != input_partition[node]) {
+                                ++migrated_nodes;
+                        }
+                } endfor
+                std::cout << "migrated nodes\t" << migrated_nodes << std::endl;
+        }
+        std::cout << "finalobjective  " << metrics.edge_cut                 << std::endl;
+        std::cout << "bnd \t\t"         << metrics.boundary_nodes           << std::endl;
+        std::cout << "balance \t"       << metrics.balance                  << std::endl;
+        std::cout << "max_comm_vol \t"  << metrics.max_communication_volume << std::endl;
+        std::cout << "total_comm_vol \t" << metrics.total_communication_volume << std::endl;
+        std::cout << "quotient_edges \t" << metrics.quotient_graph_edges << std::endl;
+
+        if (partition_config.enable_mapping) {
+                // the blocks are renamed to their PEs, so the written partition is the process mapping
+                t.restart();
+                parallel::process_mapping mapping(partition_config.group_sizes, partition_config.distances);
+                graph_access Q;
+                parallel::process_mapping::build_quotient_graph(G, Q);
+
+                std::vector<PartitionID> pe_of_block;
+                mapping.construct_mapping(Q, pe_of_block);
+                parallel::process_mapping::cost_type constructed_objective = mapping.objective(Q, pe_of_block);
+                mapping.perform_local_search(partition_config, Q, pe_of_block);
+
+                parallel::parallel_for_index(NodeID(0), G.number_of_nodes(), [&](NodeID node) {
+                        G.setPartitionIndex(node, pe_of_block[G.getPartitionIndex(node)]);
+                });
+                std::cout << "time spent for mapping " << t.elapsed() << std::endl;
+
+                std::vector<PartitionID> identity(partition_config.k);
+                std::iota(identity.begin(), identity.end(), 0);
+                std::cout << "identity mapping objective\t" << mapping.objective(Q, identity) << std::endl;
+                std::cout << "constructed mapping objective\t" << constructed_objective << std::endl;
+                std::cout << "mapping objective\t" << mapping.objective(Q, pe_of_block) << std::endl;
         }
-        std::cout << "finalobjective  " << qm.edge_cut(G)                 << std::endl;
-        std::cout << "bnd \t\t"         << qm.boundary_nodes(G)           << std::endl;
-        std::cout << "balance \t"       << qm.balance(G)                  << std::endl;
-        std::cout << "max_comm_vol \t"  << qm.max_communication_volume(G) << std::endl;
 
         if (!partition_config.label_propagation_refinement) {
                 std::cout << "Two way refinement:" << std::endl;
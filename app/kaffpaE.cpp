@@ -32,6 +32,7 @@
 #include "algorithms/cycle_search.h"
 #include "balance_configuration.h"
 #include "data_structure/graph_access.h"
+#include "data_structure/parallel/thread_pool.h"
 #include "graph_io.h"
 #include "macros_assertions.h"
 #include "parallel_mh/parallel_mh_async.h"
@@ -42,9 +43,33 @@
 #include "random_functions.h"
 #include "timer.h"
 
+#ifdef __gnu_linux__
+#include <numa.h>
+#endif
+#include <thread>
+
+// ranks that run on the same machine get disjoint sets of cores
+static uint32_t compute_main_core(uint32_t num_threads) {
+        MPI_Comm node_comm;
+        MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+        int local_rank = 0;
+        MPI_Comm_rank(node_comm, &local_rank);
+        MPI_Comm_free(&node_comm);
+
+        uint32_t num_cores = std::max(std::thread::hardware_concurrency(), 1u);
+        uint32_t main_core = local_rank * num_threads;
+        if (main_core + num_threads > num_cores) {
+                std::cout << "rank " << MPI::COMM_WORLD.Get_rank()
+                          << ": not enough cores for " << num_threads << " threads per rank, cores are shared" << std::endl;
+                main_core = num_cores > num_threads ? main_core % (num_cores - num_threads + 1) : 0;
+        }
+        return main_core;
+}
+
 int main(int argn, char **argv) {
 
-        MPI::Init(argn, argv);    /* starts MPI */
+        // only the main thread of a rank communicates, the workers of the thread pool never call MPI
+        MPI::Init_thread(argn, argv, MPI_THREAD_FUNNELED);    /* starts MPI */
 
         PartitionConfig partition_config;
         std::string graph_filename;
@@ -61,6 +86,20 @@ int main(int argn, char **argv) {
                 return 0;
         }
 
+        if (partition_config.num_threads > 1) {
+#ifdef __gnu_linux__
+                if (numa_available() >= 0) {
+                        numa_set_interleave_mask(numa_all_nodes_ptr);
+                }
+#endif
+                partition_config.main_core = compute_main_core(partition_config.num_threads);
+                parallel::PinToCore(partition_config.main_core);
+                parallel::g_thread_pool.Resize(partition_config.num_threads - 1, partition_config.main_core + 1);
+
+                // the island of a rank runs on its main thread, so the combine operators may use the pool
+                partition_config.parallel_combine_operators = true;
+        }
+
         partition_config.LogDump(stdout);
         partition_config.graph_filename = graph_filename.substr( graph_filename.find_last_of( '/' ) +1 );
 
@@ -99,6 +138,7 @@ int main(int argn, char **argv) {
         
         int rank = MPI::COMM_WORLD.Get_rank();
         if( rank == ROOT ) {
+                std::cout <<  "threads per rank " << partition_config.num_threads  << std::endl;
                 std::cout <<  "time spent for partitioning " << t.elapsed()  << std::endl;
                 std::cout <<  "time spent in neg. cycle detection " <<  cycle_search::total_time  << std::endl;
                 std::cout <<  "time spent in neg. cycle detection (rel) " <<  (cycle_search::total_time/t.elapsed()*100)  << std::endl;
@@ -123,6 +163,7 @@ int main(int argn, char **argv) {
 
                 graph_io::writePartition(G, filename.str());
         }
- 
+
+        parallel::g_thread_pool.Clear();
         MPI::Finalize();
 }
@@ -0,0 +1,86 @@
+#include <argtable2.h>
+#include <iostream>
+#include <math.h>
+#include <regex.h>
+#include <sstream>
+#include <stdio.h>
+#include <string.h>
+
+#include "balance_configuration.h"
+#include "data_structure/graph_access.h"
+#include "graph_io.h"
+#include "parallel_mh/threaded/threaded_mh.h"
+#include "parse_parameters.h"
+#include "partition/partition_config.h"
+#include "quality_metrics.h"
+#include "random_functions.h"
+#include "timer.h"
+
+// kaffpaE with one island per thread instead of one island per MPI process
+int main(int argn, char **argv) {
+        PartitionConfig partition_config;
+        std::string graph_filename;
+        bool is_graph_weighted = false;
+        bool suppress_output   = false;
+        bool recursive         = false;
+
+        int ret_code = parse_parameters(argn, argv,
+                                        partition_config, graph_filename,
+                                        is_graph_weighted, suppress_output,
+                                        recursive);
+
+        if(ret_code) {
+                return 0;
+        }
+
+        partition_config.LogDump(stdout);
+        partition_config.graph_filename = graph_filename.substr( graph_filename.find_last_of( '/' ) +1 );
+
+        graph_access G;
+
+        timer t;
+        graph_io::readGraphWeighted(G, graph_filename);
+        std::cout << "io time: " << t.elapsed()  << std::endl;
+
+        G.set_partition_count(partition_config.k);
+        partition_config.kaffpaE = true; // necessary for balance configuration
+
+        balance_configuration bc;
+        bc.configurate_balance( partition_config, G);
+
+        if(partition_config.input_partition != "") {
+                std::cout <<  "reading input partition" << std::endl;
+                graph_io::readPartition(G, partition_config.input_partition);
+                partition_config.graph_allready_partitioned = true;
+        }
+
+        std::cout << "Num islands\t" << partition_config.num_threads << std::endl;
+        t.restart();
+
+        // one island per thread, the islands run the parallel components with their single thread
+        parallel::threaded_mh mh(partition_config.num_threads, partition_config.num_threads);
+        mh.perform_partitioning(partition_config, G);
+
+        std::cout <<  "time spent for partitioning " << t.elapsed()  << std::endl;
+
+        // output some information about the partition that we have computed
+        quality_metrics qm;
+        EdgeWeight cut =  qm.edge_cut(G);
+        std::cout << "cut \t\t"         << cut                            << std::endl;
+        std::cout << "finalobjective  " << cut                            << std::endl;
+        std::cout << "bnd \t\t"         << qm.boundary_nodes(G)           << std::endl;
+        std::cout << "balance \t"       << qm.balance(G)                  << std::endl;
+        std::cout << "max_comm_vol \t"  << qm.max_communication_volume(G) << std::endl;
+
+        // write the partition to the disc
+        std::stringstream filename;
+        if(!partition_config.filename_output.compare("")) {
+                // no output filename given
+                filename << "tmppartition" << partition_config.k;
+        } else {
+                filename << partition_config.filename_output;
+        }
+
+        graph_io::writePartition(G, filename.str());
+        return 0;
+}
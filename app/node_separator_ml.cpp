@@ -28,12 +28,18 @@
 #include <stdio.h>
 #include <string.h> 
 
+#ifdef __gnu_linux__
+#include <numa.h>
+#endif
+
 #include "balance_configuration.h"
 #include "data_structure/graph_access.h"
+#include "data_structure/parallel/thread_pool.h"
 #include "graph_io.h"
 #include "macros_assertions.h"
 #include "parse_parameters.h"
 #include "partition/graph_partitioner.h"
+#include "partition/node_ordering/nested_dissection.h"
 #include "partition/partition_config.h"
 #include "partition/uncoarsening/refinement/cycle_improvements/cycle_refinement.h"
 #include "partition/uncoarsening/separator/vertex_separator_algorithm.h"
@@ -44,6 +50,14 @@
 
 int main(int argn, char **argv) {
 
+#ifdef __gnu_linux__
+        if (numa_available() < 0) {
+                printf("No NUMA support available on this system.\n");
+                exit(1);
+        }
+        numa_set_interleave_mask(numa_all_nodes_ptr);
+#endif
+
         PartitionConfig partition_config;
         std::string graph_filename;
 
@@ -85,6 +99,10 @@ int main(int argn, char **argv) {
         srand(partition_config.seed);
         random_functions::setSeed(partition_config.seed);
 
+        // pin main thread to core
+        parallel::PinToCore(partition_config.main_core);
+        parallel::g_thread_pool.Resize(partition_config.num_threads - 1);
+
         std::cout <<  "graph has " <<  G.number_of_nodes() <<  " nodes and " <<  G.number_of_edges() <<  " edges"  << std::endl;
         // ***************************** perform partitioning ***************************************       
         t.restart();
@@ -143,4 +161,28 @@ int main(int argn, char **argv) {
 		std::cout <<  "not a separator -- please report this bug"  << std::endl;
         }
 #endif
+
+        if(!partition_config.ordering_output.empty()) {
+                // the dissection computes its own top level separator
+                t.restart();
+                std::vector<NodeID> ordering;
+                parallel::nested_dissection dissection;
+                dissection.perform_nested_dissection(partition_config, G, ordering);
+                double parallel_time = t.elapsed();
+                std::cout <<  "time spent to compute nested dissection ordering " << parallel_time  << std::endl;
+                graph_io::writeVector(ordering, partition_config.ordering_output);
+
+                if(partition_config.compare_serial_ordering) {
+                        // without pool threads both the separators and the recursion are serial
+                        parallel::g_thread_pool.Resize(0);
+                        t.restart();
+                        std::vector<NodeID> serial_ordering;
+                        dissection.perform_nested_dissection(partition_config, G, serial_ordering);
+                        double serial_time = t.elapsed();
+                        parallel::g_thread_pool.Resize(partition_config.num_threads - 1);
+
+                        std::cout <<  "time spent to compute serial nested dissection ordering " << serial_time  << std::endl;
+                        std::cout <<  "nested dissection speedup " << serial_time / parallel_time  << std::endl;
+                }
+        }
 }
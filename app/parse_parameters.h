@@ -25,6 +25,8 @@
 #define PARSE_PARAMETERS_GPJMGSM8
 
 #include <omp.h>
+#include <sstream>
+#include <string>
 #include "configuration.h"
 
 int parse_parameters(int argn, char **argv, 
@@ -83,7 +85,7 @@ int parse_parameters(int argn, char **argv,
         struct arg_dbl *imbalance                            = arg_dbl0(NULL, "imbalance", NULL, "Desired balance. Default: 3 (%).");
         struct arg_rex *initial_partition                    = arg_rex0(NULL, "initial_partitioner", "^(metis|scotch|hybrid|bubbling|squeez|metaheuristic|recursive)$", "PARTITIONER", REG_EXTENDED, "Type of matchings to use during coarsening. One of {metis, scotch, bubbling, hybrid, recursive)." );
         struct arg_lit *initial_partition_optimize           = arg_lit0(NULL, "initial_partition_optimize", "Enables postoptimization of initial partition.");
-        struct arg_rex *bipartition_algorithm                = arg_rex0(NULL, "bipartition_algorithm", "^(bfs|fm|squeezing)$", "TYPE", REG_EXTENDED, "Type of bipartition algorithm to use in case of recursive partitioning. One of " " {bfs, fm, squeezing}."  );
+        struct arg_rex *bipartition_algorithm                = arg_rex0(NULL, "bipartition_algorithm", "^(bfs|fm|squeezing|random|spectral)$", "TYPE", REG_EXTENDED, "Type of bipartition algorithm to use in case of recursive partitioning. One of " " {bfs, fm, squeezing, random, spectral}."  );
         struct arg_rex *permutation_quality                  = arg_rex0(NULL, "permutation_quality", "^(none|fast|good|cacheefficient)$", "QUALITY", REG_EXTENDED, "The quality of permutations to use. One of {none, fast," " good, cacheefficient}."  );
         struct arg_rex *permutation_during_refinement        = arg_rex0(NULL, "permutation_during_refinement", "^(none|fast|good)$", "QUALITY", REG_EXTENDED, "The quality of permutations to use during 2way fm refinement. One of {none, fast," " good}."  );
         struct arg_int *fm_search_limit                      = arg_int0(NULL, "fm_search_limit", NULL, "Search limit for 2way fm local search: Default 1 (%).");
@@ -114,7 +116,9 @@ int parse_parameters(int argn, char **argv,
         struct arg_int *initial_partition_optimize_multitry_fm_alpha = arg_int0(NULL, "initial_partition_optimize_multitry_fm_limits", NULL, "Initial Partition Optimize Multitry FM limits. (Default: 20)");
         struct arg_int *initial_partition_optimize_multitry_rounds   = arg_int0(NULL, "initial_partition_optimize_multitry_rounds", NULL, "(Default: 100)");
 
-#ifdef MODE_KAFFPAs
+#ifdef MODE_NODESEP
+        struct arg_rex *preconfiguration                     = arg_rex0(NULL, "preconfiguration", "^(strong|eco|fast|fastsocial|ecosocial|strongsocial|eco_parallel|fast_parallel)$", "VARIANT", REG_EXTENDED, "Use a preconfiguration. (Default: eco) [strong|eco|fast|eco_parallel|fast_parallel]." );
+#elif defined MODE_KAFFPAs
         struct arg_rex *preconfiguration                     = arg_rex0(NULL, "preconfiguration", "^(strong|eco|fast|fastsocial|ecosocial|strongsocial|strongsocial_parallel|fastsocial_parallel|fastmultitry|fastmultitry_parallel)$", "VARIANT", REG_EXTENDED, "Use a preconfiguration. (Default: eco) [strong|eco|fast|fastsocial|ecosocial|strongsocial|strongsocial_parallel|fastsocial_parallel|fastmultitry|fastmultitry_parallel]." );
 #else
         struct arg_rex *preconfiguration                     = arg_rex0(NULL, "preconfiguration", "^(strong|eco|fast|fastsocial|fastsocialmultitry|fastsocialmultitry_parallel|fastsocialmultitry_parallel_fast|ecosocialmultitry_parallel|ecosocialmultitry_parallel_fast|ecosocial|strongsocial|strongsocial_parallel|fastsocial_parallel|fastmultitry|fastmultitry_parallel)$", "VARIANT", REG_EXTENDED, "Use a preconfiguration. (Default: strong) [strong|eco|fast|fastsocial|fastsocialmultitry|fastsocialmultitry_parallel|fastsocialmultitry_parallel_fast|ecosocialmultitry_parallel|ecosocialmultitry_parallel_fast|ecosocial|strongsocial|strongsocial_parallel|fastsocial_parallel|fastmultitry|fastmultitry_parallel]." );
@@ -168,7 +172,7 @@ int parse_parameters(int argn, char **argv,
         struct arg_int *num_threads                          = arg_int0(NULL, "num_threads", NULL, "Number of threads to use. Should be at least 1");
         struct arg_lit *parallel_lp                          = arg_lit0(NULL, "parallel_lp", "(Default: disabled)");
         struct arg_rex *block_size_unit                      = arg_rex0(NULL, "block_size_unit", "^(nodes|edges)$", "VARIANT", REG_EXTENDED, "How to calculate sizes of blocks. Using nodes or edges.");
-        struct arg_rex *parallel_lp_type                     = arg_rex0(NULL, "parallel_lp_type", "^(queue|no_queue)$", "VARIANT", REG_EXTENDED, "Type of parallel lp algorithm. Use queue or not.");
+        struct arg_rex *parallel_lp_type                     = arg_rex0(NULL, "parallel_lp_type", "^(queue|no_queue|async)$", "VARIANT", REG_EXTENDED, "Type of parallel lp algorithm. One of {queue, no_queue, async}. async processes active vertices without rounds.");
         struct arg_int *block_size                           = arg_int0(NULL, "block_size", NULL, "Size of block in parallel lp. Should be at least 1");
         struct arg_rex *apply_move_strategy                  = arg_rex0(NULL, "move_strategy", "^(local_search|gain_recalculation|reactivate_vertices|skip)$", "VARIANT", REG_EXTENDED, "Strategy to apply for conflicting vertices. Default: local search. [local search | gain_recalculation|reactivate_vertices|skip].");
         struct arg_dbl *chernoff_stop_probability            = arg_dbl0(NULL, "chernoff_stop_probability", NULL, "Probability of stop for Chernoff stopping rule");
@@ -197,6 +201,24 @@ int parse_parameters(int argn, char **argv,
         struct arg_lit *remove_edges_in_matching             = arg_lit0(NULL, "remove_edges_in_matching", "Remove edges in parallel local max or not. (Default: false)");
         struct arg_rex *multitry_kway_global_loop_stopping_rule = arg_rex0(NULL, "multitry_kway_global_loop_stopping_rule", "^(iteration|percentage|quantile)$", "VARIANT", REG_EXTENDED, "Stopping rule for global loop :iteration, percentage, quantile. Default: iteration.");
         struct arg_rex *multitry_kway_local_loop_stopping_rule = arg_rex0(NULL, "multitry_kway_local_loop_stopping_rule", "^(iteration|percentage|quantile)$", "VARIANT", REG_EXTENDED, "Stopping rule for local loop :iteration, percentage, quantile. Default: percentage.");
+        struct arg_lit *use_fast_bucket_queues               = arg_lit0(NULL, "use_fast_bucket_queues", "Use non-virtual bucket queues in parallel local search. (Default: disabled)");
+        struct arg_lit *lp_block_weight_reservations         = arg_lit0(NULL, "lp_block_weight_reservations", "Admit moves of parallel lp refinement by reserving block weight with per thread quotas. (Default: disabled)");
+        struct arg_int *lp_reservation_batch_divisor         = arg_int0(NULL, "lp_reservation_batch_divisor", NULL, "A thread reserves at most upper bound / (divisor * num threads) of a block at once. (Default: 4)");
+        struct arg_lit *initial_partitioning_portfolio       = arg_lit0(NULL, "initial_partitioning_portfolio", "Parallel initial partitioning cycles through bfs, fm, random and spectral bisection and stops dominated repetitions early. (Default: disabled)");
+        struct arg_dbl *initial_partitioning_time_budget     = arg_dbl0(NULL, "initial_partitioning_time_budget", NULL, "Time in seconds after which portfolio initial partitioning starts no new repetitions. 0 means no limit. (Default: 0)");
+        struct arg_lit *deep_multilevel                      = arg_lit0(NULL, "deep_multilevel", "Coarsen to a small graph and split blocks during uncoarsening until k blocks are reached. Requires k to be a power of two and a parallel refinement.");
+        struct arg_int *deep_multilevel_nodes_per_block      = arg_int0(NULL, "deep_multilevel_nodes_per_block", NULL, "Blocks are only split on levels with at least this many nodes per new block. (Default: 60)");
+        struct arg_str *edge_delta                           = arg_str0(NULL, "edge_delta", NULL, "Edge delta file to apply to the graph. Requires --input_partition, the input partition is carried over to the changed graph and refined around the changes.");
+        struct arg_int *incremental_hops                     = arg_int0(NULL, "incremental_hops", NULL, "Nodes within this many hops of a change are refined in incremental mode. (Default: 2)");
+        struct arg_str *batch_k                              = arg_str0(NULL, "batch_k", NULL, "Comma separated list of block counts, e.g. 8,16,32. The graph is coarsened once and partitioned for every block count. Partitions are written to <output_filename>.k<k>.");
+        struct arg_int *sep_num_lp_rounds                    = arg_int0(NULL, "sep_num_lp_rounds", NULL, "Number of label propagation rounds of the parallel separator refinement. (Default: 16)");
+        struct arg_str *ordering_output                      = arg_str0(NULL, "ordering_output", NULL, "Compute a nested dissection ordering and write it to this file. Line i contains the elimination position of node i.");
+        struct arg_int *dissection_rec_limit                 = arg_int0(NULL, "dissection_rec_limit", NULL, "Nested dissection does not split subgraphs with at most this many nodes. (Default: 120)");
+        struct arg_lit *compare_serial_ordering              = arg_lit0(NULL, "compare_serial_ordering", "Also compute the nested dissection ordering with a single thread and report both running times.");
+        struct arg_rex *refinement_objective                 = arg_rex0(NULL, "refinement_objective", "^(cut|volume)$", "VARIANT", REG_EXTENDED, "Objective of the parallel refinement: cut or volume (total communication volume). Default: cut.");
+        struct arg_lit *enable_mapping                       = arg_lit0(NULL, "enable_mapping", "Map the blocks onto the PEs of a hierarchical machine after partitioning. The output file contains the PE of every node.");
+        struct arg_str *hierarchy_parameter_string           = arg_str0(NULL, "hierarchy_parameter_string", NULL, "Group sizes of the machine hierarchy from the bottom, e.g. 4:8:8 for 4 cores per socket, 8 sockets per node and 8 nodes per rack. The product has to be k.");
+        struct arg_str *distance_parameter_string            = arg_str0(NULL, "distance_parameter_string", NULL, "Distances between two PEs in the same group of each level of the hierarchy, e.g. 1:10:100.");
 
         struct arg_end *end                                  = arg_end(100);
 
@@ -277,6 +299,21 @@ int parse_parameters(int argn, char **argv,
                 remove_edges_in_matching,
                 multitry_kway_global_loop_stopping_rule,
                 multitry_kway_local_loop_stopping_rule,
+                use_fast_bucket_queues,
+                lp_block_weight_reservations,
+                lp_reservation_batch_divisor,
+                initial_partitioning_portfolio,
+                initial_partitioning_time_budget,
+                deep_multilevel,
+                deep_multilevel_nodes_per_block,
+                global_cycle_iterations,
+                edge_delta,
+                incremental_hops,
+                batch_k,
+                refinement_objective,
+                enable_mapping,
+                hierarchy_parameter_string,
+                distance_parameter_string,
 #elif defined MODE_EVALUATOR
                 k,   
                 preconfiguration, 
@@ -306,6 +343,11 @@ int parse_parameters(int argn, char **argv,
                 //sep_full_boundary_ip,
                 //sep_edge_rating_during_ip,
                 //sep_faster_ns,
+                num_threads,
+                sep_num_lp_rounds,
+                ordering_output,
+                dissection_rec_limit,
+                compare_serial_ordering,
 #elif defined MODE_PARTITIONTOVERTEXSEPARATOR
                 k, input_partition, 
                 filename_output, 
@@ -325,6 +367,7 @@ int parse_parameters(int argn, char **argv,
 		balance_edges,
                 input_partition,
                 filename_output, 
+                num_threads,
 #elif defined MODE_LABELPROPAGATION
                 cluster_upperbound,
                 label_propagation_iterations,
@@ -384,6 +427,10 @@ int parse_parameters(int argn, char **argv,
                         cfg.eco_separator(partition_config);
                 } else if (strcmp("fast", preconfiguration->sval[0]) == 0) {
                         cfg.fast_separator(partition_config);
+                } else if (strcmp("eco_parallel", preconfiguration->sval[0]) == 0) {
+                        cfg.eco_separator_parallel(partition_config);
+                } else if (strcmp("fast_parallel", preconfiguration->sval[0]) == 0) {
+                        cfg.fast_separator_parallel(partition_config);
                 } else if (strcmp("fastsocial", preconfiguration->sval[0]) == 0) {
                         std::cout <<  "fastsocial not supported yet"  << std::endl;
                         exit(0);
@@ -791,7 +838,7 @@ int parse_parameters(int argn, char **argv,
         }
 
         if(global_cycle_iterations->count > 0) {
-                partition_config.global_cycle_iterations = global_cycle_iterations->ival[0];
+                partition_config.global_cycle_iterations = std::max(global_cycle_iterations->ival[0], 1);
         }
 
         if(level_split->count > 0) {
@@ -968,6 +1015,10 @@ int parse_parameters(int argn, char **argv,
                         partition_config.bipartition_algorithm = BIPARTITION_BFS;
                 } else if (strcmp("fm", bipartition_algorithm->sval[0]) == 0) {
                         partition_config.bipartition_algorithm = BIPARTITION_FM;
+                } else if (strcmp("random", bipartition_algorithm->sval[0]) == 0) {
+                        partition_config.bipartition_algorithm = BIPARTITION_RANDOM;
+                } else if (strcmp("spectral", bipartition_algorithm->sval[0]) == 0) {
+                        partition_config.bipartition_algorithm = BIPARTITION_SPECTRAL;
                 } else {
                         fprintf(stderr, "Invalid bipartition algorthim: \"%s\"\n", bipartition_algorithm->sval[0]);
                         exit(0);
@@ -1116,10 +1167,12 @@ int parse_parameters(int argn, char **argv,
         }
 
         if (parallel_lp_type->count > 0) {
-                if(strcmp("nodes", parallel_lp_type->sval[0]) == 0) {
+                if(strcmp("queue", parallel_lp_type->sval[0]) == 0) {
                         partition_config.parallel_lp_type = ParallelLPType::QUEUE;
-                } else if (strcmp("edges", parallel_lp_type->sval[0]) == 0) {
+                } else if (strcmp("no_queue", parallel_lp_type->sval[0]) == 0) {
                         partition_config.parallel_lp_type = ParallelLPType::NO_QUEUE;
+                } else if (strcmp("async", parallel_lp_type->sval[0]) == 0) {
+                        partition_config.parallel_lp_type = ParallelLPType::ASYNC_QUEUE;
                 } else {
                         fprintf(stderr, "Invalid parallel_lp_type value: \"%s\"\n", parallel_lp_type->sval[0]);
                         exit(0);
@@ -1274,6 +1327,115 @@ int parse_parameters(int argn, char **argv,
                 }
         }
 
+        if (use_fast_bucket_queues->count > 0) {
+                partition_config.use_fast_bucket_queues = true;
+        }
+
+        if (lp_block_weight_reservations->count > 0) {
+                partition_config.lp_block_weight_reservations = true;
+        }
+
+        if (lp_reservation_batch_divisor->count > 0) {
+                partition_config.lp_reservation_batch_divisor = std::max(lp_reservation_batch_divisor->ival[0], 1);
+        }
+
+        if (initial_partitioning_portfolio->count > 0) {
+                partition_config.initial_partitioning_portfolio = true;
+        }
+
+        if (initial_partitioning_time_budget->count > 0) {
+                partition_config.initial_partitioning_time_budget = initial_partitioning_time_budget->dval[0];
+        }
+
+        if (deep_multilevel->count > 0) {
+                partition_config.deep_multilevel = true;
+        }
+
+        if (deep_multilevel_nodes_per_block->count > 0) {
+                partition_config.deep_multilevel_nodes_per_block = std::max(deep_multilevel_nodes_per_block->ival[0], 2);
+        }
+
+        if (edge_delta->count > 0) {
+                partition_config.edge_delta = edge_delta->sval[0];
+        }
+
+        if (incremental_hops->count > 0) {
+                partition_config.incremental_hops = std::max(incremental_hops->ival[0], 0);
+        }
+
+        if (batch_k->count > 0) {
+                std::stringstream ss(batch_k->sval[0]);
+                std::string value;
+                partition_config.batch_k.clear();
+                while (std::getline(ss, value, ',')) {
+                        int k_value = atoi(value.c_str());
+                        if (k_value < 2) {
+                                fprintf(stderr, "Invalid number of blocks in batch: \"%s\"\n", value.c_str());
+                                exit(0);
+                        }
+                        partition_config.batch_k.push_back(k_value);
+                }
+        }
+
+        if (sep_num_lp_rounds->count > 0) {
+                partition_config.sep_num_lp_rounds = std::max(sep_num_lp_rounds->ival[0], 0);
+        }
+
+        if (ordering_output->count > 0) {
+                partition_config.ordering_output = ordering_output->sval[0];
+        }
+
+        if (dissection_rec_limit->count > 0) {
+                partition_config.dissection_rec_limit = std::max(dissection_rec_limit->ival[0], 1);
+        }
+
+        if (compare_serial_ordering->count > 0) {
+                partition_config.compare_serial_ordering = true;
+        }
+
+        if (refinement_objective->count > 0) {
+                if(strcmp("cut", refinement_objective->sval[0]) == 0) {
+                        partition_config.refinement_objective = RefinementObjective::CUT;
+                } else if (strcmp("volume", refinement_objective->sval[0]) == 0) {
+                        partition_config.refinement_objective = RefinementObjective::COMMUNICATION_VOLUME;
+                } else {
+                        fprintf(stderr, "Invalid refinement_objective variant: \"%s\"\n", refinement_objective->sval[0]);
+                        exit(0);
+                }
+        }
+
+        if (enable_mapping->count > 0) {
+                partition_config.enable_mapping = true;
+        }
+
+        if (hierarchy_parameter_string->count > 0) {
+                std::stringstream ss(hierarchy_parameter_string->sval[0]);
+                std::string value;
+                partition_config.group_sizes.clear();
+                while (std::getline(ss, value, ':')) {
+                        int group_size = atoi(value.c_str());
+                        if (group_size < 1) {
+                                fprintf(stderr, "Invalid group size in hierarchy: \"%s\"\n", value.c_str());
+                                exit(0);
+                        }
+                        partition_config.group_sizes.push_back(group_size);
+                }
+        }
+
+        if (distance_parameter_string->count > 0) {
+                std::stringstream ss(distance_parameter_string->sval[0]);
+                std::string value;
+                partition_config.distances.clear();
+                while (std::getline(ss, value, ':')) {
+                        int distance = atoi(value.c_str());
+                        if (distance < 0) {
+                                fprintf(stderr, "Invalid distance in hierarchy: \"%s\"\n", value.c_str());
+                                exit(0);
+                        }
+                        partition_config.distances.push_back(distance);
+                }
+        }
+
         return 0;
 }
 
@@ -20,7 +20,10 @@
  * this program.  If not, see <http://www.gnu.org/licenses/>.
  *****************************************************************************/
 
+#include <algorithm>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include "kaHIP_interface.h"
 #include "../lib/data_structure/graph_access.h"
 #include "../lib/io/graph_io.h"
@@ -35,6 +38,8 @@
 #include "../lib/partition/uncoarsening/separator/vertex_separator_algorithm.h"
 #include "../app/configuration.h"
 #include "../app/balance_configuration.h"
+#include "../lib/data_structure/parallel/silent_output.h"
+#include "../lib/data_structure/parallel/thread_context.h"
 #include "../data_structure/parallel/thread_pool.h"
 
 #ifdef __gnu_linux__
@@ -43,6 +48,10 @@
 
 using namespace std;
 
+// The calls without a session share the process wide thread pool and the pinning of its threads,
+// hence they are serialized. Sessions have their own pools and run next to them.
+static std::mutex g_thread_pool_mutex;
+
 void internal_build_graph( PartitionConfig & partition_config, 
                            int* n, 
                            int* vwgt, 
@@ -84,11 +93,9 @@ void internal_kaffpa_call(PartitionConfig & partition_config,
                           int* edgecut, 
                           int* part) {
 
-        streambuf* backup = cout.rdbuf();
-        ofstream ofs;
-        ofs.open("/dev/null");
+        std::unique_ptr<parallel::silent_output> silence;
         if(suppress_output) {
-               cout.rdbuf(ofs.rdbuf()); 
+               silence = std::make_unique<parallel::silent_output>();
         }
 
         partition_config.imbalance = 100*(*imbalance);
@@ -104,33 +111,20 @@ void internal_kaffpa_call(PartitionConfig & partition_config,
 
         quality_metrics qm;
         *edgecut = qm.edge_cut(G);
-
-        ofs.close();
-        cout.rdbuf(backup);
 }
 
-void kaffpa(int* n, 
-                   int* vwgt, 
-                   int* xadj, 
-                   int* adjcwgt, 
-                   int* adjncy, 
-                   int* nparts, 
-                   double* imbalance, 
-                   bool suppress_output, 
-                   int seed,
-                   int mode,
-                   uint32_t num_threads,
-                   int* edgecut, 
-                   int* part) {
-        configuration cfg;
-        PartitionConfig partition_config;
-        partition_config.k = *nparts;
-        partition_config.num_threads = num_threads;
-
+// numa and thread pool settings which are changed by the parallel modes
+struct internal_mode_state {
 #ifdef __gnu_linux__
         bitmask* old_numa_mask_ptr = nullptr;
 #endif
+        bool parallel = false;
+        std::unique_lock<std::mutex> lock;
+};
 
+// returns true for the parallel modes
+bool internal_configure_mode(PartitionConfig & partition_config, int mode) {
+        configuration cfg;
         switch( mode ) {
                 case FAST: 
                         cfg.fast(partition_config);
@@ -151,40 +145,240 @@ void kaffpa(int* n,
                         cfg.strongsocial(partition_config);
                         break;
 
-                case FASTSOCIAL_PARALLEL:
+                // FASTSOCIAL_PARALLEL has the same value
                 case FASTSOCIALMULTITRY_PARALLEL:
-#ifdef __gnu_linux__
-                        if (numa_available() < 0) {
-                                printf("No NUMA support available on this system.\n");
-                                exit(1);
-                        }
-                        numa_set_interleave_mask(numa_all_nodes_ptr);
-                        old_numa_mask_ptr = numa_get_interleave_mask();
-#endif
                         if (mode == FASTSOCIALMULTITRY_PARALLEL) {
                                 cfg.fastsocialmultitry_parallel(partition_config);
                         } else if (mode == FASTSOCIAL_PARALLEL) {
                                 cfg.fastsocial_parallel(partition_config);
                         }
-
-                        parallel::PinToCore(partition_config.main_core);
-                        parallel::g_thread_pool.Resize(partition_config.num_threads - 1);
-                        break;
+                        return true;
                 default: 
                         cfg.eco(partition_config);
                         break;
         }
+        return false;
+}
 
-        partition_config.seed = seed;
-        internal_kaffpa_call(partition_config, suppress_output, n, vwgt, xadj, adjcwgt, adjncy, nparts, imbalance, edgecut, part);
+void internal_begin_mode(PartitionConfig & partition_config, int mode, internal_mode_state & state) {
+        state.lock = std::unique_lock<std::mutex>(g_thread_pool_mutex);
+        if (internal_configure_mode(partition_config, mode)) {
+#ifdef __gnu_linux__
+                if (numa_available() < 0) {
+                        printf("No NUMA support available on this system.\n");
+                        exit(1);
+                }
+                state.old_numa_mask_ptr = numa_get_interleave_mask();
+                numa_set_interleave_mask(numa_all_nodes_ptr);
+#endif
+                parallel::PinToCore(partition_config.main_core);
+                parallel::g_thread_pool.Resize(partition_config.num_threads - 1);
+                state.parallel = true;
+        }
+}
 
-        if (mode == FASTSOCIALMULTITRY_PARALLEL || mode == FASTSOCIAL_PARALLEL) {
+void internal_end_mode(internal_mode_state & state) {
+        if (state.parallel) {
                 parallel::Unpin();
                 parallel::g_thread_pool.Clear();
 #ifdef __gnu_linux__
-                numa_set_interleave_mask(old_numa_mask_ptr);
+                numa_set_interleave_mask(state.old_numa_mask_ptr);
+                numa_bitmask_free(state.old_numa_mask_ptr);
 #endif
         }
+        state.lock.unlock();
+}
+
+void kaffpa(int* n, 
+                   int* vwgt, 
+                   int* xadj, 
+                   int* adjcwgt, 
+                   int* adjncy, 
+                   int* nparts, 
+                   double* imbalance, 
+                   bool suppress_output, 
+                   int seed,
+                   int mode,
+                   uint32_t num_threads,
+                   int* edgecut, 
+                   int* part) {
+        PartitionConfig partition_config;
+        partition_config.k = *nparts;
+        partition_config.num_threads = num_threads;
+
+        internal_mode_state state;
+        internal_begin_mode(partition_config, mode, state);
+
+        partition_config.seed = seed;
+        internal_kaffpa_call(partition_config, suppress_output, n, vwgt, xadj, adjcwgt, adjncy, nparts, imbalance, edgecut, part);
+
+        internal_end_mode(state);
+}
+
+void kaffpa_batch(int* n, 
+                  int* vwgt, 
+                  int* xadj, 
+                  int* adjcwgt, 
+                  int* adjncy, 
+                  int* nparts, 
+                  int num_k,
+                  double* imbalance, 
+                  bool suppress_output, 
+                  int seed,
+                  int mode,
+                  uint32_t num_threads,
+                  int* edgecut, 
+                  int* part) {
+        PartitionConfig partition_config;
+        partition_config.k = *std::max_element(nparts, nparts + num_k);
+        partition_config.num_threads = num_threads;
+
+        internal_mode_state state;
+        internal_begin_mode(partition_config, mode, state);
+        partition_config.seed = seed;
+
+        std::unique_ptr<parallel::silent_output> silence;
+        if(suppress_output) {
+               silence = std::make_unique<parallel::silent_output>();
+        }
+
+        partition_config.imbalance = 100*(*imbalance);
+        graph_access G;     
+        internal_build_graph( partition_config, n, vwgt, xadj, adjcwgt, adjncy, G);
+
+        std::vector<PartitionID> ks(nparts, nparts + num_k);
+        std::vector< std::vector<PartitionID> > partitions;
+        graph_partitioner partitioner;
+        partitioner.perform_batch_partitioning(partition_config, G, ks, partitions);
+
+        quality_metrics qm;
+        for( int i = 0; i < num_k; i++) {
+                forall_nodes(G, node) {
+                        G.setPartitionIndex(node, partitions[i][node]);
+                        part[i * (*n) + node] = partitions[i][node];
+                } endfor
+                edgecut[i] = qm.edge_cut(G);
+        }
+        silence.reset();
+
+        internal_end_mode(state);
+}
+
+// A session keeps its graph buffers and its thread pool between calls. The threads of the pool are
+// not pinned to cores, since the calls of several sessions may run at the same time.
+struct kahip_session {
+        kahip_session(uint32_t threads, int session_mode, bool parallel_mode, bool suppress)
+                :       num_threads(threads)
+                ,       mode(session_mode)
+                ,       parallel(parallel_mode)
+                ,       suppress_output(suppress)
+                ,       pool(parallel_mode ? threads - 1 : 0, false)
+        {}
+
+        uint32_t num_threads;
+        int mode;
+        bool parallel;
+        bool suppress_output;
+        graph_access G;
+        parallel::TThreadPoolWithTaskQueuePerThread pool;
+};
+
+// builds the graph in the storage of G, which is reused if it is large enough
+void internal_build_graph_view(PartitionConfig & partition_config, const kahip_graph_view* graph, graph_access & G) {
+        NodeID n = graph->n;
+        G.start_construction(n, graph->xadj[n]);
+        for( NodeID i = 0; i < n; i++) {
+                NodeID node = G.new_node();
+                G.setNodeWeight(node, graph->vwgt != NULL ? graph->vwgt[i] : 1);
+                G.setPartitionIndex(node, 0);
+
+                for( int e = graph->xadj[i]; e < graph->xadj[i+1]; e++) {
+                        EdgeID e_bar = G.new_edge(node, graph->adjncy[e]);
+                        G.setEdgeWeight(e_bar, graph->adjcwgt != NULL ? graph->adjcwgt[e] : 1);
+                }
+        }
+        G.finish_construction();
+        G.set_partition_count(partition_config.k);
+
+        srand(partition_config.seed);
+        random_functions::setSeed(partition_config.seed);
+
+        balance_configuration bc;
+        bc.configurate_balance( partition_config, G);
+}
+
+kahip_session* kahip_session_create(uint32_t num_threads, int mode, bool suppress_output) {
+        PartitionConfig mode_config;
+        bool parallel_mode = internal_configure_mode(mode_config, mode);
+#ifdef __gnu_linux__
+        if (parallel_mode && numa_available() < 0) {
+                printf("No NUMA support available on this system.\n");
+                exit(1);
+        }
+#endif
+        return new kahip_session(std::max<uint32_t>(num_threads, 1), mode, parallel_mode, suppress_output);
+}
+
+int kahip_partition(kahip_session* session, const kahip_graph_view* graph, const kahip_params* params,
+                    int* edgecut, int* part) {
+        if (session == NULL || graph == NULL || params == NULL || params->nparts < 1) {
+                return 1;
+        }
+
+        PartitionConfig partition_config;
+        partition_config.k           = params->nparts;
+        partition_config.num_threads = session->num_threads;
+        internal_configure_mode(partition_config, session->mode);
+        partition_config.seed        = params->seed;
+        partition_config.imbalance   = 100*params->imbalance;
+        if (params->objective == OBJECTIVE_COMMUNICATION_VOLUME) {
+                partition_config.refinement_objective = RefinementObjective::COMMUNICATION_VOLUME;
+        }
+
+        // the parallel components of this call and the output guard only see this thread
+        parallel::thread_context context;
+        context.pool        = &session->pool;
+        context.pin_threads = false;
+        parallel::scoped_thread_context scope(context);
+
+        std::unique_ptr<parallel::silent_output> silence;
+        if(session->suppress_output) {
+               silence = std::make_unique<parallel::silent_output>();
+        }
+
+#ifdef __gnu_linux__
+        // the interleave mask belongs to the calling thread
+        bitmask* old_numa_mask_ptr = nullptr;
+        if (session->parallel) {
+                old_numa_mask_ptr = numa_get_interleave_mask();
+                numa_set_interleave_mask(numa_all_nodes_ptr);
+        }
+#endif
+
+        graph_access& G = session->G;
+        internal_build_graph_view(partition_config, graph, G);
+
+        graph_partitioner partitioner;
+        partitioner.perform_partitioning(partition_config, G);
+
+        forall_nodes(G, node) {
+                part[node] = G.getPartitionIndex(node);
+        } endfor
+
+        quality_metrics qm;
+        *edgecut = qm.edge_cut(G);
+
+#ifdef __gnu_linux__
+        if (session->parallel) {
+                numa_set_interleave_mask(old_numa_mask_ptr);
+                numa_bitmask_free(old_numa_mask_ptr);
+        }
+#endif
+        return 0;
+}
+
+void kahip_session_destroy(kahip_session* session) {
+        delete session;
 }
 
 void kaffpa_balance_NE(int* n, 
@@ -199,6 +393,7 @@ void kaffpa_balance_NE(int* n,
                    int mode,
                    int* edgecut, 
                    int* part) {
+        std::lock_guard<std::mutex> lock(g_thread_pool_mutex);
         configuration cfg;
         PartitionConfig partition_config;
         partition_config.k = *nparts;
@@ -246,11 +441,9 @@ void internal_nodeseparator_call(PartitionConfig & partition_config,
                           int** separator) {
 
         //first perform std partitioning using KaFFPa
-        streambuf* backup = cout.rdbuf();
-        ofstream ofs;
-        ofs.open("/dev/null");
+        std::unique_ptr<parallel::silent_output> silence;
         if(suppress_output) {
-               cout.rdbuf(ofs.rdbuf()); 
+               silence = std::make_unique<parallel::silent_output>();
         }
 
         partition_config.k         = *nparts;
@@ -328,9 +521,6 @@ void internal_nodeseparator_call(PartitionConfig & partition_config,
                         }
                 } endfor
         }
-
-        ofs.close();
-        cout.rdbuf(backup);
 }
 
 
@@ -346,6 +536,7 @@ void node_separator(int* n,
                     int mode,
                     int* num_separator_vertices, 
                     int** separator) {
+        std::lock_guard<std::mutex> lock(g_thread_pool_mutex);
         configuration cfg;
         PartitionConfig partition_config;
         partition_config.k = *nparts;
@@ -41,6 +41,10 @@ const int STRONGSOCIAL   = 5;
 const int FASTSOCIALMULTITRY_PARALLEL = 6;
 const int FASTSOCIAL_PARALLEL = 6;
 
+// objectives of the parallel refinement
+const int OBJECTIVE_CUT                  = 0;
+const int OBJECTIVE_COMMUNICATION_VOLUME = 1;
+
 // same data structures as in metis 
 // edgecut and part are output parameters
 // part has to be an array of n ints
@@ -49,6 +53,44 @@ void kaffpa(int* n, int* vwgt, int* xadj,
                    double* imbalance,  bool suppress_output, int seed, int mode, uint32_t num_threads,
                    int* edgecut, int* part);
 
+// partitions the graph once for each of the num_k block counts in nparts, the coarsening is
+// only done once. edgecut has num_k entries and part num_k*n entries, the partition for
+// nparts[i] is stored in part[i*n, (i+1)*n)
+void kaffpa_batch(int* n, int* vwgt, int* xadj, 
+                  int* adjcwgt, int* adjncy, int* nparts, int num_k,
+                  double* imbalance,  bool suppress_output, int seed, int mode, uint32_t num_threads,
+                  int* edgecut, int* part);
+
+// session based interface, a session keeps its threads and graph buffers alive between calls.
+// Sessions can partition at the same time from different threads, a single session must only
+// be used by one thread at a time.
+typedef struct kahip_session kahip_session;
+
+// graph in metis format, vwgt and adjcwgt may be NULL for unit weights
+typedef struct {
+        int n;
+        const int* xadj;
+        const int* adjncy;
+        const int* vwgt;
+        const int* adjcwgt;
+} kahip_graph_view;
+
+// a zero initialized objective minimizes the edge cut
+typedef struct {
+        int nparts;
+        double imbalance;
+        int seed;
+        int objective;
+} kahip_params;
+
+kahip_session* kahip_session_create(uint32_t num_threads, int mode, bool suppress_output);
+
+// part has to be an array of n ints, returns 0 on success
+int kahip_partition(kahip_session* session, const kahip_graph_view* graph, const kahip_params* params,
+                    int* edgecut, int* part);
+
+void kahip_session_destroy(kahip_session* session);
+
 // balance constraint on nodes and edges
 void kaffpa_balance_NE(int* n, int* vwgt, int* xadj, 
                 int* adjcwgt, int* adjncy, int* nparts, 
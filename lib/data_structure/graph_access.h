@@ -26,6 +26,7 @@
 #include <bitset>
 #include <cassert>
 #include <iostream>
+#include <stdexcept>
 #include <vector>
 
 #include "definitions.h"
@@ -56,29 +57,66 @@ class basicGraph {
     friend class graph_access;
 
 public:
-    basicGraph() : m_building_graph(false) {
+    basicGraph() : m_node_array(nullptr), m_node_array_size(0), m_edge_array(nullptr), m_edge_array_size(0),
+                   m_shared_topology(false), m_building_graph(false) {
     }
 
 //private:
     //methods only to be used by friend class
     EdgeID number_of_edges() {
-        return m_edges.size();
+        return m_edge_array_size;
     }
 
     NodeID number_of_nodes() {
-        return m_nodes.size()-1;
+        return m_node_array_size-1;
     }
 
     inline EdgeID get_first_edge(const NodeID & node) {
-        return m_nodes[node].firstEdge;
+        return m_node_array[node].firstEdge;
     }
 
     inline EdgeID get_first_invalid_edge(const NodeID & node) {
-        return m_nodes[node+1].firstEdge;
+        return m_node_array[node+1].firstEdge;
+    }
+
+    inline Node & checked_node(const NodeID & node) {
+        if (node >= m_node_array_size) {
+            throw std::out_of_range("node out of range");
+        }
+        return m_node_array[node];
+    }
+
+    inline Edge & checked_edge(const EdgeID & edge) {
+        if (edge >= m_edge_array_size) {
+            throw std::out_of_range("edge out of range");
+        }
+        return m_edge_array[edge];
+    }
+
+    // uses the nodes and edges of other instead of own ones. Only the properties
+    // (partition index, edge ratings) are owned, other must outlive this graph
+    // and its topology must not be changed meanwhile.
+    void share_topology(basicGraph & other) {
+        std::vector<Node>().swap(m_nodes);
+        std::vector<Edge>().swap(m_edges);
+        m_refinement_node_props = other.m_refinement_node_props;
+        m_coarsening_edge_props.resize(other.m_edge_array_size);
+
+        m_node_array       = other.m_node_array;
+        m_node_array_size  = other.m_node_array_size;
+        m_edge_array       = other.m_edge_array;
+        m_edge_array_size  = other.m_edge_array_size;
+        m_shared_topology  = true;
+    }
+
+    bool has_shared_topology() const {
+        return m_shared_topology;
     }
 
     // construction of the graph
     void start_construction(NodeID n, EdgeID m) {
+        // a new topology is built, the shared one is released
+        m_shared_topology = false;
         m_building_graph = true;
         node             = 0;
         e                = 0;
@@ -89,15 +127,18 @@ public:
         m_refinement_node_props.resize(n+1);
         m_edges.resize(m);
         m_coarsening_edge_props.resize(m);
+        update_topology_arrays();
 
         m_nodes[node].firstEdge = e;
     }
 
     void start_construction(std::vector<Node>& nodes, std::vector<Edge>& edges) {
+        m_shared_topology = false;
         m_nodes.swap(nodes);
         m_edges.swap(edges);
         m_refinement_node_props.resize(m_nodes.size());
         m_coarsening_edge_props.resize(m_edges.size());
+        update_topology_arrays();
     }
 
     EdgeID new_edge(NodeID source, NodeID target) {
@@ -133,6 +174,7 @@ public:
 
         m_edges.resize(e);
         m_coarsening_edge_props.resize(e);
+        update_topology_arrays();
 
         m_building_graph = false;
 
@@ -152,7 +194,23 @@ public:
     
     std::vector<refinementNode> m_refinement_node_props;
     std::vector<coarseningEdge> m_coarsening_edge_props;
+
+    // the topology is accessed through these arrays. They point into m_nodes / m_edges
+    // or into the arrays of another graph (see share_topology)
+    Node * m_node_array;
+    size_t m_node_array_size;
+    Edge * m_edge_array;
+    size_t m_edge_array_size;
+    bool   m_shared_topology;
         
+    void update_topology_arrays() {
+        ALWAYS_ASSERT(!m_shared_topology);
+        m_node_array      = m_nodes.data();
+        m_node_array_size = m_nodes.size();
+        m_edge_array      = m_edges.data();
+        m_edge_array_size = m_edges.size();
+    }
+
     // construction properties
     bool m_building_graph;
     int m_last_source;
@@ -249,6 +307,10 @@ class graph_access {
                 //Count get_node_queue_index(NodeID node);
 
                 void copy(graph_access & Gcopy);
+
+                // Gshared becomes a graph with the same nodes and edges as this graph. Only the
+                // partition and the coarsening properties are copied, the topology is shared.
+                void share_topology(graph_access & Gshared);
         //private:
                 basicGraph * graphref;     
                 bool         m_max_degree_computed;
@@ -278,8 +340,9 @@ inline EdgeID graph_access::new_edge(NodeID source, NodeID target) {
 }
 
 inline void graph_access::remove_edge(EdgeID e, EdgeID end) {
+        ASSERT_TRUE(!graphref->has_shared_topology());
         if (end > e) {
-                std::swap(graphref->m_edges[e], graphref->m_edges[end - 1]);
+                std::swap(graphref->m_edge_array[e], graphref->m_edge_array[end - 1]);
                 std::swap(graphref->m_coarsening_edge_props[e], graphref->m_coarsening_edge_props[end - 1]);
         }
 }
@@ -311,14 +374,14 @@ inline void graph_access::resizeSecondPartitionIndex(unsigned no_nodes) {
 
 inline EdgeID graph_access::get_first_edge(NodeID node) {
 #ifdef NDEBUG
-        return graphref->m_nodes[node].firstEdge;
+        return graphref->m_node_array[node].firstEdge;
 #else
-        return graphref->m_nodes.at(node).firstEdge;
+        return graphref->checked_node(node).firstEdge;
 #endif
 }
 
 inline EdgeID graph_access::get_first_invalid_edge(NodeID node) {
-        return graphref->m_nodes[node+1].firstEdge;
+        return graphref->m_node_array[node+1].firstEdge;
 }
 
 inline PartitionID graph_access::get_partition_count() {
@@ -368,41 +431,43 @@ inline void graph_access::setPartitionIndex(NodeID node, PartitionID id) {
 
 inline NodeWeight graph_access::getNodeWeight(NodeID node){
 #ifdef NDEBUG
-        return graphref->m_nodes[node].weight;        
+        return graphref->m_node_array[node].weight;        
 #else
-        return graphref->m_nodes.at(node).weight;        
+        return graphref->checked_node(node).weight;        
 #endif
 }
 
 inline void graph_access::setNodeWeight(NodeID node, NodeWeight weight){
+        ASSERT_TRUE(!graphref->has_shared_topology());
 #ifdef NDEBUG
-        graphref->m_nodes[node].weight = weight;        
+        graphref->m_node_array[node].weight = weight;        
 #else
-        graphref->m_nodes.at(node).weight = weight;        
+        graphref->checked_node(node).weight = weight;        
 #endif
 }
 
 inline EdgeWeight graph_access::getEdgeWeight(EdgeID edge){
 #ifdef NDEBUG
-        return graphref->m_edges[edge].weight;        
+        return graphref->m_edge_array[edge].weight;        
 #else
-        return graphref->m_edges.at(edge).weight;        
+        return graphref->checked_edge(edge).weight;        
 #endif
 }
 
 inline void graph_access::setEdgeWeight(EdgeID edge, EdgeWeight weight){
+        ASSERT_TRUE(!graphref->has_shared_topology());
 #ifdef NDEBUG
-        graphref->m_edges[edge].weight = weight;        
+        graphref->m_edge_array[edge].weight = weight;        
 #else
-        graphref->m_edges.at(edge).weight = weight;        
+        graphref->checked_edge(edge).weight = weight;        
 #endif
 }
 
 inline NodeID graph_access::getEdgeTarget(EdgeID edge){
 #ifdef NDEBUG
-        return graphref->m_edges[edge].target;        
+        return graphref->m_edge_array[edge].target;        
 #else
-        return graphref->m_edges.at(edge).target;        
+        return graphref->checked_edge(edge).target;        
 #endif
 }
 
@@ -423,12 +488,12 @@ inline void graph_access::setEdgeRating(EdgeID edge, EdgeRatingType rating){
 }
 
 inline EdgeWeight graph_access::getNodeDegree(NodeID node) {
-        return graphref->m_nodes[node+1].firstEdge-graphref->m_nodes[node].firstEdge;
+        return graphref->m_node_array[node+1].firstEdge-graphref->m_node_array[node].firstEdge;
 }
 
 inline EdgeWeight graph_access::getWeightedNodeDegree(NodeID node) {
 	EdgeWeight degree = 0;
-	for( unsigned e = graphref->m_nodes[node].firstEdge; e < graphref->m_nodes[node+1].firstEdge; ++e) {
+	for( unsigned e = graphref->m_node_array[node].firstEdge; e < graphref->m_node_array[node+1].firstEdge; ++e) {
 		degree += getEdgeWeight(e);
 	}
         return degree;
@@ -458,9 +523,9 @@ inline int* graph_access::UNSAFE_metis_style_xadj_array() {
         basicGraph& ref = *graphref;
 
         forall_nodes(ref, n) {
-                xadj[n] = graphref->m_nodes[n].firstEdge;
+                xadj[n] = graphref->m_node_array[n].firstEdge;
         } endfor
-        xadj[graphref->number_of_nodes()] = graphref->m_nodes[graphref->number_of_nodes()].firstEdge;
+        xadj[graphref->number_of_nodes()] = graphref->m_node_array[graphref->number_of_nodes()].firstEdge;
         return xadj;
 }
 
@@ -469,7 +534,7 @@ inline int* graph_access::UNSAFE_metis_style_adjncy_array() {
         int * adjncy    = new int[graphref->number_of_edges()];
         basicGraph& ref = *graphref;
         forall_edges(ref, e) {
-                adjncy[e] = graphref->m_edges[e].target;
+                adjncy[e] = graphref->m_edge_array[e].target;
         } endfor 
 
         return adjncy;
@@ -481,7 +546,7 @@ inline int* graph_access::UNSAFE_metis_style_vwgt_array() {
         basicGraph& ref = *graphref;
 
         forall_nodes(ref, n) {
-                vwgt[n] = (int)graphref->m_nodes[n].weight;
+                vwgt[n] = (int)graphref->m_node_array[n].weight;
         } endfor
         return vwgt;
 }
@@ -491,7 +556,7 @@ inline int* graph_access::UNSAFE_metis_style_adjwgt_array() {
         basicGraph& ref = *graphref;
 
         forall_edges(ref, e) {
-                adjwgt[e] = (int)graphref->m_edges[e].weight;
+                adjwgt[e] = (int)graphref->m_edge_array[e].weight;
         } endfor 
 
         return adjwgt;
@@ -557,4 +622,13 @@ inline void graph_access::copy(graph_access & G_bar) {
         G_bar.finish_construction();
 }
 
+inline void graph_access::share_topology(graph_access & G_bar) {
+        G_bar.graphref->share_topology(*graphref);
+        G_bar.m_max_degree_computed = false;
+        G_bar.m_max_degree          = 0;
+        G_bar.m_unit_weighted_edges = m_unit_weighted_edges;
+        G_bar.m_partition_count     = m_partition_count;
+        G_bar.m_separator_block_ID  = m_separator_block_ID;
+}
+
 #endif /* end of include guard: GRAPH_ACCESS_EFRXO4X2 */
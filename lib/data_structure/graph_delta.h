@@ -0,0 +1,25 @@
+#pragma once
+
+#include <vector>
+
+#include "definitions.h"
+
+// Changes of a graph between two partitioning runs. Node ids refer to the old graph,
+// new nodes get the ids number_of_nodes(), number_of_nodes() + 1, ... in the order of new_node_weights.
+struct graph_delta {
+        struct edge {
+                NodeID source;
+                NodeID target;
+                EdgeWeight weight;
+        };
+
+        std::vector<edge> added_edges;
+        std::vector<edge> removed_edges;
+        std::vector<std::pair<NodeID, NodeWeight>> node_weights;
+        std::vector<NodeWeight> new_node_weights;
+
+        bool empty() const {
+                return added_edges.empty() && removed_edges.empty() && node_weights.empty()
+                       && new_node_weights.empty();
+        }
+};
@@ -23,7 +23,8 @@
 #include "data_structure/parallel/algorithm.h"
 #include "graph_hierarchy.h"
 
-graph_hierarchy::graph_hierarchy() : m_current_coarser_graph(NULL), 
+graph_hierarchy::graph_hierarchy() : m_persistent(false),
+                                     m_current_coarser_graph(NULL), 
                                      m_current_coarse_mapping(NULL){
 
 }
@@ -38,15 +39,62 @@ graph_hierarchy::~graph_hierarchy() {
                 if(m_to_delete_hierachies[i] != NULL)
                 delete m_to_delete_hierachies[i];
         }
+
+        if(m_persistent) {
+                // the finest level is the input graph
+                for( unsigned i = 1; i < m_levels.size(); i++) {
+                        delete m_levels[i];
+                }
+        }
 }
 
 void graph_hierarchy::push_back(graph_access * G, CoarseMapping * coarse_mapping) {
         m_the_graph_hierarchy.push(G);
         m_the_mappings.push(coarse_mapping);
 	m_to_delete_mappings.push_back(coarse_mapping);
+        m_levels.push_back(G);
+        m_level_mappings.push_back(coarse_mapping);
         m_coarsest_graph = G;
 }
 
+void graph_hierarchy::set_persistent(bool persistent) {
+        m_persistent = persistent;
+}
+
+bool graph_hierarchy::is_persistent() {
+        return m_persistent;
+}
+
+void graph_hierarchy::rewind() {
+        rewind(m_levels.size() - 1);
+}
+
+void graph_hierarchy::rewind(unsigned int coarsest_level) {
+        ASSERT_TRUE(m_persistent);
+        ASSERT_LT(coarsest_level, m_levels.size());
+        while(!m_the_graph_hierarchy.empty()) {
+                m_the_graph_hierarchy.pop();
+                m_the_mappings.pop();
+        }
+
+        // the mapping of the coarsest level is never used for projection
+        for( unsigned i = 0; i <= coarsest_level; i++) {
+                m_the_graph_hierarchy.push(m_levels[i]);
+                m_the_mappings.push(m_level_mappings[i]);
+        }
+        m_coarsest_graph         = m_levels[coarsest_level];
+        m_current_coarser_graph  = NULL;
+        m_current_coarse_mapping = NULL;
+}
+
+unsigned int graph_hierarchy::number_of_levels() {
+        return m_levels.size();
+}
+
+graph_access* graph_hierarchy::get_level(unsigned int level) {
+        return m_levels[level];
+}
+
 graph_access* graph_hierarchy::pop_finer_and_project() {
         graph_access* finer = pop_coarsest();
 
@@ -40,6 +40,17 @@ public:
         graph_access  * pop_finer_and_project_ns( PartialBoundary & separator );
         graph_access  * get_coarsest();
         CoarseMapping * get_mapping_of_current_finer();
+
+        // a persistent hierarchy owns its coarse graphs, uncoarsening does not delete them
+        // and rewind() restores all levels so that the hierarchy can be uncoarsened again
+        void set_persistent(bool persistent);
+        bool is_persistent();
+        void rewind();
+        // restores the levels up to coarsest_level, which becomes the coarsest graph
+        void rewind(unsigned int coarsest_level);
+        // level 0 is the input graph
+        unsigned int number_of_levels();
+        graph_access  * get_level(unsigned int level);
                
         bool isEmpty();
         unsigned int size();
@@ -51,6 +62,9 @@ private:
         std::stack<CoarseMapping*>  m_the_mappings;
         std::vector<CoarseMapping*> m_to_delete_mappings;
         std::vector<graph_access*>  m_to_delete_hierachies;
+        std::vector<graph_access*>  m_levels;
+        std::vector<CoarseMapping*> m_level_mappings;
+        bool m_persistent;
         graph_access  * m_current_coarser_graph;
         graph_access  * m_coarsest_graph;
         CoarseMapping * m_current_coarse_mapping;
@@ -274,7 +274,7 @@ private:
 template<typename Iterator, typename Functor>
 static void parallel_for_each(Iterator begin, Iterator end, Functor functor) {
         std::vector<std::future<void>> futures;
-        futures.reserve(g_thread_pool.NumThreads());
+        futures.reserve(current_thread_pool().NumThreads());
 
         std::atomic<size_t> offset(0);
         size_t size = end - begin;
@@ -297,8 +297,8 @@ static void parallel_for_each(Iterator begin, Iterator end, Functor functor) {
                 }
         };
 
-        for (uint32_t i = 0; i < g_thread_pool.NumThreads(); ++i) {
-                futures.push_back(g_thread_pool.Submit(i, task, i + 1));
+        for (uint32_t i = 0; i < current_thread_pool().NumThreads(); ++i) {
+                futures.push_back(current_thread_pool().Submit(i, task, i + 1));
         }
         task(uint32_t(0));
 
@@ -312,7 +312,7 @@ static void parallel_for_index(Integer_type begin, Integer_type end, Functor fun
         static_assert(std::is_integral<Integer_type>::value, "Integral required.");
 
         std::vector<std::future<void>> futures;
-        futures.reserve(g_thread_pool.NumThreads());
+        futures.reserve(current_thread_pool().NumThreads());
 
         std::atomic<size_t> offset(0);
         size_t size = end - begin;
@@ -335,8 +335,8 @@ static void parallel_for_index(Integer_type begin, Integer_type end, Functor fun
                 }
         };
 
-        for (uint32_t i = 0; i < g_thread_pool.NumThreads(); ++i) {
-                futures.push_back(g_thread_pool.Submit(i, task, i + 1));
+        for (uint32_t i = 0; i < current_thread_pool().NumThreads(); ++i) {
+                futures.push_back(current_thread_pool().Submit(i, task, i + 1));
         }
         task(0);
 
@@ -349,7 +349,7 @@ template <typename Iterator>
 void random_shuffle(Iterator begin, Iterator end, uint32_t num_threads) {
         ALWAYS_ASSERT(num_threads > 0);
 
-        parallel::g_thread_pool.Clear();
+        parallel::current_thread_pool().Clear();
         parallel::Unpin();
         omp_set_dynamic(false);
         omp_set_num_threads(num_threads);
@@ -358,14 +358,14 @@ void random_shuffle(Iterator begin, Iterator end, uint32_t num_threads) {
 
         omp_set_num_threads(0);
         parallel::PinToCore(0);
-        parallel::g_thread_pool.Resize(num_threads - 1);
+        parallel::current_thread_pool().Resize(num_threads - 1);
 }
 
 template <typename InputIterator, typename OutputIterator>
 void partial_sum(InputIterator begin, InputIterator end, OutputIterator out, uint32_t num_threads) {
         ALWAYS_ASSERT(num_threads > 0);
 
-        parallel::g_thread_pool.Clear();
+        parallel::current_thread_pool().Clear();
         parallel::Unpin();
         omp_set_dynamic(false);
         omp_set_num_threads(num_threads);
@@ -374,7 +374,7 @@ void partial_sum(InputIterator begin, InputIterator end, OutputIterator out, uin
 
         omp_set_num_threads(0);
         parallel::PinToCore(0);
-        parallel::g_thread_pool.Resize(num_threads - 1);
+        parallel::current_thread_pool().Resize(num_threads - 1);
 }
 
 // calculates prefix sum for each prefix not including last element of the prefix
@@ -401,13 +401,13 @@ template <typename Iterator, typename Functor>
 void sort(Iterator begin, Iterator end, Functor functor, uint32_t num_threads) {
         ALWAYS_ASSERT(num_threads > 0);
 
-        parallel::g_thread_pool.Clear();
+        parallel::current_thread_pool().Clear();
         parallel::Unpin();
 
         ips4o::parallel::sort(begin, end, functor, num_threads);
 
         parallel::PinToCore(0);
-        parallel::g_thread_pool.Resize(num_threads - 1);
+        parallel::current_thread_pool().Resize(num_threads - 1);
 }
 
 }
\ No newline at end of file
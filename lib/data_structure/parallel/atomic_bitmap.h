@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "data_structure/parallel/atomics.h"
+
+namespace parallel {
+
+// Bitmap which can be read and modified by several threads concurrently.
+class atomic_bitmap {
+public:
+        using word_type = uint64_t;
+        static constexpr uint32_t bits_per_word = 64;
+
+        explicit atomic_bitmap(size_t size = 0)
+                :       m_size(size)
+                ,       m_words(num_words(size))
+        {}
+
+        atomic_bitmap(const atomic_bitmap&) = delete;
+        atomic_bitmap& operator=(const atomic_bitmap&) = delete;
+
+        atomic_bitmap(atomic_bitmap&&) = default;
+        atomic_bitmap& operator=(atomic_bitmap&&) = default;
+
+        static inline size_t num_words(size_t size) {
+                return (size + bits_per_word - 1) / bits_per_word;
+        }
+
+        inline size_t size() const {
+                return m_size;
+        }
+
+        inline size_t num_words() const {
+                return m_words.size();
+        }
+
+        inline bool test(size_t index) const {
+                return m_words[index / bits_per_word].load(std::memory_order_relaxed) & mask(index);
+        }
+
+        inline void set(size_t index) {
+                m_words[index / bits_per_word].fetch_or(mask(index), std::memory_order_relaxed);
+        }
+
+        inline void reset(size_t index) {
+                m_words[index / bits_per_word].fetch_and(~mask(index), std::memory_order_relaxed);
+        }
+
+        // returns true if the bit was not set before and this call has set it
+        inline bool test_and_set(size_t index) {
+                word_type bit = mask(index);
+                auto& word = m_words[index / bits_per_word];
+                if (word.load(std::memory_order_relaxed) & bit) {
+                        return false;
+                }
+                return !(word.fetch_or(bit, std::memory_order_acq_rel) & bit);
+        }
+
+        // returns true if the bit was set before and this call has reset it
+        inline bool test_and_reset(size_t index) {
+                word_type bit = mask(index);
+                auto& word = m_words[index / bits_per_word];
+                return word.fetch_and(~bit, std::memory_order_acq_rel) & bit;
+        }
+
+        inline word_type get_word(size_t word_index) const {
+                return m_words[word_index].load(std::memory_order_relaxed);
+        }
+
+        // only for words that are not accessed by other threads at the same time
+        inline void store_word(size_t word_index, word_type word) {
+                m_words[word_index].store(word, std::memory_order_relaxed);
+        }
+
+        // calls functor for every set bit of the words [word_begin, word_end)
+        template <typename TFunctor>
+        inline void for_each_set_bit(size_t word_begin, size_t word_end, TFunctor&& functor) const {
+                for (size_t word_index = word_begin; word_index < word_end; ++word_index) {
+                        word_type word = get_word(word_index);
+                        while (word != 0) {
+                                uint32_t bit = __builtin_ctzll(word);
+                                functor(word_index * bits_per_word + bit);
+                                word &= word - 1;
+                        }
+                }
+        }
+
+        inline size_t count(size_t word_begin, size_t word_end) const {
+                size_t res = 0;
+                for (size_t word_index = word_begin; word_index < word_end; ++word_index) {
+                        res += __builtin_popcountll(get_word(word_index));
+                }
+                return res;
+        }
+
+        inline void clear() {
+                for (auto& word : m_words) {
+                        word.store(0, std::memory_order_relaxed);
+                }
+        }
+
+private:
+        size_t m_size;
+        std::vector<AtomicWrapper<word_type>> m_words;
+
+        static inline word_type mask(size_t index) {
+                return word_type(1) << (index % bits_per_word);
+        }
+};
+
+}
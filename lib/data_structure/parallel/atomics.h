@@ -88,6 +88,14 @@ struct AtomicWrapper {
                 return m_atomic.fetch_sub(value, order);
         }
 
+        inline T fetch_or(T value, std::memory_order order = std::memory_order_seq_cst) {
+                return m_atomic.fetch_or(value, order);
+        }
+
+        inline T fetch_and(T value, std::memory_order order = std::memory_order_seq_cst) {
+                return m_atomic.fetch_and(value, order);
+        }
+
         inline T exchange(T desired, std::memory_order order = std::memory_order_seq_cst) {
                 return m_atomic.exchange(desired, order);
         }
@@ -0,0 +1,239 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "data_structure/graph_access.h"
+#include "definitions.h"
+
+namespace parallel {
+
+// Gains of a node for the total communication volume, i.e. the sum over all nodes of the number of
+// foreign blocks in their neighborhood. Moving a node changes its own term and the terms of its neighbors, so the
+// gain needs the block connectivity counts of the node and of every neighbor. The counts are kept in round stamped
+// arrays of size k which are reset in constant time, hence every thread owns one instance and evaluates gains
+// against its own view of the partition. A local search may cache the counts of the neighbors and keep them up
+// to date with its moves instead of counting the neighborhoods of all neighbors for every gain.
+class block_connectivity {
+public:
+        explicit block_connectivity(PartitionID k)
+                :       m_node_counts(k)
+                ,       m_neighbor_counts(k)
+        {}
+
+        // computes the volume gains of all blocks adjacent to node except from,
+        // get_partition returns the block of a node in the view of the caller
+        template <typename partition_type>
+        void compute_gains(graph_access& G, NodeID node, PartitionID from, partition_type&& get_partition) {
+                compute_gains(G, node, from, get_partition, [&](NodeID target) {
+                        m_neighbor_counts.next_round();
+                        forall_out_edges(G, target_e, target) {
+                                m_neighbor_counts.increment(get_partition(G.getEdgeTarget(target_e)));
+                        } endfor
+                        return [this](PartitionID block) {
+                                return m_neighbor_counts.count(block);
+                        };
+                });
+        }
+
+        // as compute_gains, but the block counts of the neighbors are cached. The view of the caller
+        // may only change by moves which are reported to move() until clear_cache is called.
+        template <typename partition_type>
+        void compute_cached_gains(graph_access& G, NodeID node, PartitionID from, partition_type&& get_partition) {
+                compute_gains(G, node, from, get_partition, [&](NodeID target) {
+                        const cached_counts& counts = get_cached_counts(G, target, get_partition);
+                        return [this, &counts](PartitionID block) {
+                                return counts.count(m_cached_entries, block);
+                        };
+                });
+        }
+
+        // node moves from from to to in the view of the caller, updates the cached counts of its neighbors
+        void move(graph_access& G, NodeID node, PartitionID from, PartitionID to) {
+                if (from == to || m_cache.empty()) {
+                        return;
+                }
+                forall_out_edges(G, e, node) {
+                        auto it = m_cache.find(G.getEdgeTarget(e));
+                        if (it != m_cache.end()) {
+                                it->second.add(m_cached_entries, from, -1);
+                                it->second.add(m_cached_entries, to, 1);
+                        }
+                } endfor
+        }
+
+        void clear_cache() {
+                m_cache.clear();
+                m_cached_entries.clear();
+        }
+
+        // blocks adjacent to the node of the last call to compute_gains except its own block
+        inline const std::vector<PartitionID>& candidates() const {
+                return m_candidates;
+        }
+
+        // gain of moving the node to candidates()[i]
+        inline Gain gain(size_t i) const {
+                return m_gains[i];
+        }
+
+        // number of neighbors of the node of the last call to compute_gains in block
+        inline NodeID count(PartitionID block) const {
+                return m_node_counts.count(block);
+        }
+
+private:
+        struct count_entry {
+                PartitionID block;
+                NodeID count;
+        };
+
+        // the nonzero block counts of a node, a node has at most as many adjacent blocks as neighbors,
+        // so its entries never leave the range reserved for its degree
+        struct cached_counts {
+                size_t begin;
+                NodeID size;
+                NodeID capacity;
+
+                inline NodeID count(const std::vector<count_entry>& entries, PartitionID block) const {
+                        for (size_t i = begin; i < begin + size; ++i) {
+                                if (entries[i].block == block) {
+                                        return entries[i].count;
+                                }
+                        }
+                        return 0;
+                }
+
+                inline void add(std::vector<count_entry>& entries, PartitionID block, int delta) {
+                        for (size_t i = begin; i < begin + size; ++i) {
+                                if (entries[i].block == block) {
+                                        entries[i].count += delta;
+                                        if (entries[i].count == 0) {
+                                                entries[i] = entries[begin + size - 1];
+                                                --size;
+                                        }
+                                        return;
+                                }
+                        }
+                        // a missing block can only be added, the capacity only matters if the view was inconsistent
+                        if (delta > 0 && size < capacity) {
+                                entries[begin + size++] = {block, NodeID(delta)};
+                        }
+                }
+        };
+
+        template <typename partition_type>
+        const cached_counts& get_cached_counts(graph_access& G, NodeID node, partition_type&& get_partition) {
+                auto it = m_cache.find(node);
+                if (it != m_cache.end()) {
+                        return it->second;
+                }
+
+                cached_counts counts = {m_cached_entries.size(), 0, G.getNodeDegree(node)};
+                m_cached_entries.resize(m_cached_entries.size() + G.getNodeDegree(node));
+                forall_out_edges(G, e, node) {
+                        counts.add(m_cached_entries, get_partition(G.getEdgeTarget(e)), 1);
+                } endfor
+                return m_cache.emplace(node, counts).first->second;
+        }
+
+        // neighbor_counts(target) returns a function which returns the number of neighbors of target in a block
+        template <typename partition_type, typename neighbor_counts_type>
+        void compute_gains(graph_access& G, NodeID node, PartitionID from, partition_type& get_partition,
+                           neighbor_counts_type&& neighbor_counts) {
+                m_candidates.clear();
+                m_gains.clear();
+
+                m_node_counts.next_round();
+                forall_out_edges(G, e, node) {
+                        PartitionID block = get_partition(G.getEdgeTarget(e));
+                        if (m_node_counts.increment(block) == 1 && block != from) {
+                                m_candidates.push_back(block);
+                        }
+                } endfor
+
+                if (m_candidates.empty()) {
+                        return;
+                }
+
+                // the node itself stops to count the blocks of the candidates and starts to count from
+                Gain own_gain = m_node_counts.count(from) > 0 ? 0 : 1;
+                Gain removal_gain = 0;
+                m_gains.assign(m_candidates.size(), own_gain);
+
+                forall_out_edges(G, e, node) {
+                        NodeID target = G.getEdgeTarget(e);
+                        PartitionID target_block = get_partition(target);
+                        auto target_count = neighbor_counts(target);
+
+                        // from leaves the neighborhood of target if node was its only neighbor there
+                        if (target_block != from && target_count(from) == 1) {
+                                ++removal_gain;
+                        }
+
+                        // a candidate enters the neighborhood of target if target had no neighbor there
+                        for (size_t i = 0; i < m_candidates.size(); ++i) {
+                                if (target_block != m_candidates[i] && target_count(m_candidates[i]) == 0) {
+                                        --m_gains[i];
+                                }
+                        }
+                } endfor
+
+                for (auto& gain : m_gains) {
+                        gain += removal_gain;
+                }
+        }
+
+        class round_counts {
+        public:
+                explicit round_counts(PartitionID k)
+                        :       m_entries(k)
+                        ,       m_round(0)
+                {}
+
+                inline void next_round() {
+                        if (++m_round == 0) {
+                                // stamps of old rounds would become valid again
+                                for (auto& entry : m_entries) {
+                                        entry.round = 0;
+                                }
+                                m_round = 1;
+                        }
+                }
+
+                inline NodeID increment(PartitionID block) {
+                        auto& entry = m_entries[block];
+                        if (entry.round != m_round) {
+                                entry.round = m_round;
+                                entry.count = 0;
+                        }
+                        return ++entry.count;
+                }
+
+                inline NodeID count(PartitionID block) const {
+                        const auto& entry = m_entries[block];
+                        return entry.round == m_round ? entry.count : 0;
+                }
+
+        private:
+                struct entry_type {
+                        uint32_t round = 0;
+                        NodeID count = 0;
+                };
+
+                std::vector<entry_type> m_entries;
+                uint32_t m_round;
+        };
+
+        round_counts m_node_counts;
+        round_counts m_neighbor_counts;
+        std::vector<PartitionID> m_candidates;
+        std::vector<Gain> m_gains;
+
+        // cached block counts of the neighbors for compute_cached_gains
+        std::unordered_map<NodeID, cached_counts> m_cache;
+        std::vector<count_entry> m_cached_entries;
+};
+
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "data_structure/parallel/algorithm.h"
+#include "data_structure/parallel/atomics.h"
+#include "definitions.h"
+
+namespace parallel {
+
+// Admission control for concurrent moves between blocks. A block weight counter is only
+// increased with a compare-and-swap that keeps it below the upper bound, so the counter is always
+// an upper bound of the real block weight and the partition never becomes imbalanced.
+// Every thread reserves capacity of a block in batches and keeps it as a local quota, hence most
+// moves do not touch the shared counters at all.
+class block_weight_reservations {
+public:
+        block_weight_reservations(Cvector<AtomicWrapper<NodeWeight>>& block_weights, NodeWeight upper_bound,
+                                  uint32_t num_threads, NodeWeight batch_size)
+                :       m_block_weights(&block_weights)
+                ,       m_upper_bound(upper_bound)
+                ,       m_num_threads(num_threads)
+                ,       m_batch_size(std::max<NodeWeight>(batch_size, 1))
+                ,       m_quotas(num_threads, thread_quotas(block_weights.size()))
+        {}
+
+        block_weight_reservations(const block_weight_reservations&) = delete;
+        block_weight_reservations& operator=(const block_weight_reservations&) = delete;
+
+        // true if the quotas can be reused for the given number of blocks and threads
+        inline bool fits(PartitionID k, uint32_t num_threads) const {
+                return m_num_threads == num_threads && m_quotas[0].get().quota.size() == k;
+        }
+
+        // reuses the quotas for new block weights, all threads must have flushed their quotas
+        inline void reset(Cvector<AtomicWrapper<NodeWeight>>& block_weights, NodeWeight upper_bound,
+                          NodeWeight batch_size) {
+                m_block_weights = &block_weights;
+                m_upper_bound = upper_bound;
+                m_batch_size = std::max<NodeWeight>(batch_size, 1);
+        }
+
+        // returns true if the thread may add weight to the block
+        inline bool reserve(uint32_t thread_id, PartitionID block, NodeWeight weight) {
+                auto& quotas = m_quotas[thread_id].get();
+                auto& quota = quotas.quota[block];
+                if (quota >= weight) {
+                        quota -= weight;
+                        return true;
+                }
+
+                NodeWeight needed = weight - quota;
+                auto& block_weight = (*m_block_weights)[block].get();
+                NodeWeight cur_weight = block_weight.load(std::memory_order_relaxed);
+                NodeWeight amount = 0;
+                do {
+                        if (cur_weight + needed > m_upper_bound) {
+                                return false;
+                        }
+                        // do not take more than a fair share of the remaining capacity
+                        NodeWeight fair_share = (m_upper_bound - cur_weight) / m_num_threads;
+                        amount = std::max(needed, std::min(m_batch_size, fair_share));
+                } while (!block_weight.compare_exchange_weak(cur_weight, cur_weight + amount,
+                                                             std::memory_order_acq_rel));
+
+                quotas.touch(block);
+                quota += amount - weight;
+                return true;
+        }
+
+        // the thread removed weight from the block, the freed capacity becomes its local quota
+        inline void release(uint32_t thread_id, PartitionID block, NodeWeight weight) {
+                auto& block_weight = (*m_block_weights)[block].get();
+                if (block_weight.load(std::memory_order_relaxed) > m_upper_bound) {
+                        // the block is overloaded, the freed capacity must not be refilled
+                        block_weight.fetch_sub(weight, std::memory_order_acq_rel);
+                        return;
+                }
+
+                auto& quotas = m_quotas[thread_id].get();
+                auto& quota = quotas.quota[block];
+                quotas.touch(block);
+                quota += weight;
+
+                if (quota > 2 * m_batch_size) {
+                        // return the surplus so that other threads can use it
+                        NodeWeight surplus = quota - m_batch_size;
+                        block_weight.fetch_sub(surplus, std::memory_order_acq_rel);
+                        quota -= surplus;
+                }
+        }
+
+        // returns all local quotas of the thread, afterwards the block weights are exact again
+        // if all threads flushed
+        inline void flush(uint32_t thread_id) {
+                auto& quotas = m_quotas[thread_id].get();
+                for (auto block : quotas.touched_blocks) {
+                        if (quotas.quota[block] > 0) {
+                                (*m_block_weights)[block].get().fetch_sub(quotas.quota[block], std::memory_order_acq_rel);
+                                quotas.quota[block] = 0;
+                        }
+                        quotas.touched[block] = false;
+                }
+                quotas.touched_blocks.clear();
+        }
+
+private:
+        struct thread_quotas {
+                explicit thread_quotas(PartitionID k)
+                        :       quota(k, 0)
+                        ,       touched(k, false)
+                {}
+
+                inline void touch(PartitionID block) {
+                        if (!touched[block]) {
+                                touched[block] = true;
+                                touched_blocks.push_back(block);
+                        }
+                }
+
+                std::vector<NodeWeight> quota;
+                std::vector<bool> touched;
+                std::vector<PartitionID> touched_blocks;
+        };
+
+        Cvector<AtomicWrapper<NodeWeight>>* m_block_weights;
+        NodeWeight m_upper_bound;
+        const NodeWeight m_num_threads;
+        NodeWeight m_batch_size;
+        Cvector<thread_quotas> m_quotas;
+};
+
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace parallel {
+
+// Immutable set of edge ids in the style of roaring bitmaps. The id space is split into chunks of 2^16 ids.
+// A chunk stores its elements as a sorted array of 16 bit offsets, or as a bitmap if it holds many elements.
+// Intersection and symmetric difference are only counted, the result set is never materialized.
+class compressed_edge_set {
+public:
+        compressed_edge_set()
+                :       m_size(0)
+        {}
+
+        // the elements of [begin, end) have to be sorted and unique
+        template <typename Iterator>
+        compressed_edge_set(Iterator begin, Iterator end)
+                :       m_size(0)
+        {
+                while (begin != end) {
+                        uint32_t key = uint32_t(*begin >> chunk_bits);
+                        Iterator chunk_end = begin;
+                        while (chunk_end != end && uint32_t(*chunk_end >> chunk_bits) == key) {
+                                ++chunk_end;
+                        }
+
+                        size_t cardinality = std::distance(begin, chunk_end);
+                        m_containers.emplace_back(key);
+                        container& c = m_containers.back();
+                        if (cardinality > max_array_size) {
+                                c.bitmap.resize(words_per_bitmap, 0);
+                                for (; begin != chunk_end; ++begin) {
+                                        uint32_t low = uint32_t(*begin & low_mask);
+                                        c.bitmap[low / 64] |= uint64_t(1) << (low % 64);
+                                }
+                        } else {
+                                c.array.reserve(cardinality);
+                                for (; begin != chunk_end; ++begin) {
+                                        c.array.push_back(uint16_t(*begin & low_mask));
+                                }
+                        }
+                        m_size += cardinality;
+                }
+        }
+
+        inline size_t size() const {
+                return m_size;
+        }
+
+        size_t intersection_size(const compressed_edge_set& other) const {
+                size_t res = 0;
+                auto it = m_containers.begin();
+                auto other_it = other.m_containers.begin();
+                while (it != m_containers.end() && other_it != other.m_containers.end()) {
+                        if (it->key < other_it->key) {
+                                ++it;
+                        } else if (other_it->key < it->key) {
+                                ++other_it;
+                        } else {
+                                res += intersection_size(*it, *other_it);
+                                ++it;
+                                ++other_it;
+                        }
+                }
+                return res;
+        }
+
+        inline size_t symmetric_difference_size(const compressed_edge_set& other) const {
+                return size() + other.size() - 2 * intersection_size(other);
+        }
+
+private:
+        static constexpr uint32_t chunk_bits = 16;
+        static constexpr uint32_t low_mask = (uint32_t(1) << chunk_bits) - 1;
+        static constexpr uint32_t words_per_bitmap = (uint32_t(1) << chunk_bits) / 64;
+        // above this size a bitmap needs less memory than an array
+        static constexpr size_t max_array_size = 4096;
+
+        struct container {
+                explicit container(uint32_t key)
+                        :       key(key)
+                {}
+
+                inline bool is_bitmap() const {
+                        return !bitmap.empty();
+                }
+
+                inline bool contains(uint16_t low) const {
+                        return bitmap[low / 64] & (uint64_t(1) << (low % 64));
+                }
+
+                uint32_t key;
+                std::vector<uint16_t> array;
+                std::vector<uint64_t> bitmap;
+        };
+
+        static size_t intersection_size(const container& a, const container& b) {
+                if (a.is_bitmap() && b.is_bitmap()) {
+                        // independent accumulators so that the popcounts are not serialized
+                        size_t res[4] = {0, 0, 0, 0};
+                        const uint64_t* a_words = a.bitmap.data();
+                        const uint64_t* b_words = b.bitmap.data();
+                        for (uint32_t i = 0; i < words_per_bitmap; i += 4) {
+                                res[0] += __builtin_popcountll(a_words[i] & b_words[i]);
+                                res[1] += __builtin_popcountll(a_words[i + 1] & b_words[i + 1]);
+                                res[2] += __builtin_popcountll(a_words[i + 2] & b_words[i + 2]);
+                                res[3] += __builtin_popcountll(a_words[i + 3] & b_words[i + 3]);
+                        }
+                        return res[0] + res[1] + res[2] + res[3];
+                }
+
+                if (a.is_bitmap() || b.is_bitmap()) {
+                        const container& bitmap = a.is_bitmap() ? a : b;
+                        const container& array = a.is_bitmap() ? b : a;
+                        size_t res = 0;
+                        for (uint16_t low : array.array) {
+                                res += bitmap.contains(low);
+                        }
+                        return res;
+                }
+
+                size_t res = 0;
+                auto it = a.array.begin();
+                auto other_it = b.array.begin();
+                while (it != a.array.end() && other_it != b.array.end()) {
+                        if (*it < *other_it) {
+                                ++it;
+                        } else if (*other_it < *it) {
+                                ++other_it;
+                        } else {
+                                ++res;
+                                ++it;
+                                ++other_it;
+                        }
+                }
+                return res;
+        }
+
+        std::vector<container> m_containers;
+        size_t m_size;
+};
+
+}
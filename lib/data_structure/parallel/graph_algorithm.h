@@ -95,7 +95,7 @@ public:
                                 }
 
                                 for (NodeID e = begin; e != end; ++e) {
-                                        edges[e] = m_G.graphref->m_edges[e].target;
+                                        edges[e] = m_G.graphref->m_edge_array[e].target;
                                 }
                         }
                 });
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <streambuf>
+
+#include "data_structure/parallel/thread_context.h"
+
+namespace parallel {
+
+// Drops the std::cout output of the current thread while at least one instance is alive. The output of
+// tasks and threads started meanwhile is dropped as well, since they run with the context of this thread.
+// Other threads, e.g. partitioning calls of other sessions, keep their output.
+class silent_output {
+public:
+        silent_output() {
+                install();
+                ++t_thread_context.num_silent_outputs;
+        }
+
+        ~silent_output() {
+                --t_thread_context.num_silent_outputs;
+        }
+
+        silent_output(const silent_output&) = delete;
+        silent_output& operator=(const silent_output&) = delete;
+
+private:
+        // forwards to the previous buffer of std::cout unless the writing thread is silenced
+        class filter_buffer : public std::streambuf {
+        public:
+                std::atomic<std::streambuf*> target{nullptr};
+
+        protected:
+                int_type overflow(int_type c) override {
+                        if (silenced() || traits_type::eq_int_type(c, traits_type::eof())) {
+                                return traits_type::not_eof(c);
+                        }
+                        return target.load()->sputc(traits_type::to_char_type(c));
+                }
+
+                std::streamsize xsputn(const char* s, std::streamsize n) override {
+                        return silenced() ? n : target.load()->sputn(s, n);
+                }
+
+                int sync() override {
+                        return target.load()->pubsync();
+                }
+
+        private:
+                static bool silenced() {
+                        return t_thread_context.num_silent_outputs > 0;
+                }
+        };
+
+        // the filter is put in front of std::cout once, and again if a program replaced the buffer of std::cout
+        static void install() {
+                static std::mutex m;
+                static filter_buffer buffer;
+                std::lock_guard<std::mutex> lock(m);
+                if (std::cout.rdbuf() != &buffer) {
+                        buffer.target = std::cout.rdbuf();
+                        std::cout.rdbuf(&buffer);
+                }
+        }
+};
+
+}
@@ -265,7 +265,7 @@ private:
 
 static void test_task_queue(size_t num_tests) {
         random rnd(256);
-        uint32_t num_threads = g_thread_pool.NumThreads() + 1;
+        uint32_t num_threads = current_thread_pool().NumThreads() + 1;
 
         std::vector<random> thread_rnds;
         thread_rnds.reserve(num_threads);
@@ -304,8 +304,8 @@ static void test_task_queue(size_t num_tests) {
                 std::vector<std::future<void>> futures;
                 futures.reserve(num_threads);
                 for (size_t id = 1; id < num_threads; ++id) {
-                        futures.push_back(g_thread_pool.Submit(id - 1, insert_task, id));
-                        //futures.push_back(g_thread_pool.Submit(insert_task, id));
+                        futures.push_back(current_thread_pool().Submit(id - 1, insert_task, id));
+                        //futures.push_back(current_thread_pool().Submit(insert_task, id));
                 }
                 insert_task(0);
 
@@ -327,8 +327,8 @@ static void test_task_queue(size_t num_tests) {
                 };
                 futures.clear();
                 for (size_t id = 1; id < num_threads; ++id) {
-                        futures.push_back(g_thread_pool.Submit(id - 1, read_task, id));
-                        //futures.push_back(g_thread_pool.Submit(read_task, id));
+                        futures.push_back(current_thread_pool().Submit(id - 1, read_task, id));
+                        //futures.push_back(current_thread_pool().Submit(read_task, id));
                 }
                 read_task(0);
 
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+
+namespace parallel {
+
+class TThreadPoolWithTaskQueuePerThread;
+
+// State of the partitioning call which runs on the current thread. The parallel components submit
+// their tasks to the pool of the context, hence calls with different pools can run side by side.
+// Tasks of a pool and threads started during a call run with the context of the thread that created them.
+struct thread_context {
+        // nullptr selects the process wide g_thread_pool
+        TThreadPoolWithTaskQueuePerThread* pool = nullptr;
+        // threads of calls which run next to other calls are not pinned to cores
+        bool pin_threads = true;
+        // number of silent_output instances of this thread
+        uint32_t num_silent_outputs = 0;
+};
+
+extern thread_local thread_context t_thread_context;
+
+class scoped_thread_context {
+public:
+        explicit scoped_thread_context(const thread_context& context)
+                :       m_backup(t_thread_context)
+        {
+                t_thread_context = context;
+        }
+
+        ~scoped_thread_context() {
+                t_thread_context = m_backup;
+        }
+
+        scoped_thread_context(const scoped_thread_context&) = delete;
+        scoped_thread_context& operator=(const scoped_thread_context&) = delete;
+
+private:
+        thread_context m_backup;
+};
+
+}
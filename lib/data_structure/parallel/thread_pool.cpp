@@ -2,4 +2,5 @@
 
 namespace parallel {
 TThreadPoolWithTaskQueuePerThread g_thread_pool(0);
-}
\ No newline at end of file
+thread_local thread_context t_thread_context;
+}
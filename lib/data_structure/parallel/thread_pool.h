@@ -3,6 +3,7 @@
 #include "data_structure/parallel/cache.h"
 #include "data_structure/parallel/metaprogramming_utils.h"
 #include "data_structure/parallel/spin_lock.h"
+#include "data_structure/parallel/thread_context.h"
 
 #include <algorithm>
 #include <atomic>
@@ -22,6 +23,9 @@ namespace parallel {
 
 static void PinToCore(size_t core) {
 #ifdef __gnu_linux__
+    if (!t_thread_context.pin_threads) {
+        return;
+    }
     cpu_set_t cpuset;
     CPU_ZERO(&cpuset);
     CPU_SET(core, &cpuset);
@@ -31,6 +35,9 @@ static void PinToCore(size_t core) {
 
 static void Unpin() {
 #ifdef __gnu_linux__
+    if (!t_thread_context.pin_threads) {
+        return;
+    }
     cpu_set_t cpuset;
     CPU_ZERO(&cpuset);
     for (size_t core = 0; core < std::thread::hardware_concurrency(); ++core) {
@@ -290,18 +297,23 @@ private:
         std::vector <std::thread> Threads;
         TThreadJoiner ThreadJoiner;
         std::unique_ptr<TQueue[]> Queues;
+        // worker i is pinned to core FirstCore + i
+        size_t FirstCore;
+        bool PinThreads;
 
         void Worker(
 #ifdef __gnu_linux__
                 uint32_t core_id
 #endif
         ) {
+                t_thread_context.pool = this;
+                t_thread_context.pin_threads = PinThreads;
 #ifdef __gnu_linux__
                 PinToCore(core_id);
 #endif
                 while (!Done) {
                         TFunctionWrapper task;
-                        if (Queues[core_id - 1].get().TryPop(task))
+                        if (Queues[core_id - FirstCore].get().TryPop(task))
                                 task();
 //                        else
 //                                std::this_thread::yield();
@@ -311,10 +323,22 @@ private:
 #endif
         }
 
+        // the task runs with the context of the submitting thread
+        template<typename TResultType>
+        void Push(size_t thread_id, std::packaged_task<TResultType()>&& task) {
+                Queues[thread_id].get().Push([task = std::move(task), context = t_thread_context]() mutable {
+                        scoped_thread_context scope(context);
+                        task();
+                });
+        }
+
 public:
-        explicit TThreadPoolWithTaskQueuePerThread(size_t threadsCount = 0)
+        // pools which run next to other pools do not pin their threads
+        explicit TThreadPoolWithTaskQueuePerThread(size_t threadsCount = 0, bool pin_threads = true)
                 :       ThreadJoiner(Threads)
                 ,       Queues(std::make_unique<TQueue[]>(threadsCount))
+                ,       FirstCore(1)
+                ,       PinThreads(pin_threads)
         {
 
                 Done = false;
@@ -334,18 +358,20 @@ public:
                 }
         }
 
-        void Resize(size_t threadsCount) {
+        // first_core is the core of the first worker, the main thread usually runs on first_core - 1
+        void Resize(size_t threadsCount, size_t first_core = 1) {
                 Done = true;
                 ThreadJoiner.Clear();
                 Threads.clear();
                 Queues = std::make_unique<TQueue[]>(threadsCount);
+                FirstCore = first_core;
 
                 Done = false;
                 Threads.reserve(threadsCount);
                 for (size_t i = 0; i < threadsCount; ++i)
                         Threads.push_back(std::thread(&TThreadPoolWithTaskQueuePerThread::Worker, this
 #ifdef __gnu_linux__
-                                , i + 1
+                                , i + FirstCore
 #endif
                         ));
 
@@ -361,8 +387,9 @@ public:
                 Threads.clear();
         }
 
+        // the workers are joined before the queues are freed
         ~TThreadPoolWithTaskQueuePerThread() {
-                Done = true;
+                Clear();
         }
 
         template<typename TFunctor, typename... TArgs>
@@ -373,7 +400,7 @@ public:
                         task(std::bind(std::forward<TFunctor>(f), std::forward<TArgs>(args)...));
                 std::future <TResultType> res(task.get_future());
 
-                Queues[thread_id].get().Push(std::move(task));
+                Push(thread_id, std::move(task));
 
                 return res;
         }
@@ -390,7 +417,7 @@ public:
                                                                             std::forward<TArgs>(args)...));
 
                         futures.push_back(task.get_future());
-                        Queues[thread_id].get().Push(std::move(task));
+                        Push(thread_id, std::move(task));
                 }
 
                 return futures;
@@ -399,16 +426,21 @@ public:
 
 extern TThreadPoolWithTaskQueuePerThread g_thread_pool;
 
+// the pool of the partitioning call running on this thread
+static TThreadPoolWithTaskQueuePerThread& current_thread_pool() {
+        return t_thread_context.pool != nullptr ? *t_thread_context.pool : g_thread_pool;
+}
+
 template<typename TFunctor>
 static void submit_for_all(TFunctor functor) {
         std::vector<std::future<void>> futures;
-        futures.reserve(g_thread_pool.NumThreads());
-        for (uint32_t i = 0; i < g_thread_pool.NumThreads(); ++i) {
+        futures.reserve(current_thread_pool().NumThreads());
+        for (uint32_t i = 0; i < current_thread_pool().NumThreads(); ++i) {
                 if constexpr (function_traits<TFunctor>::arity == 0) {
-                        futures.push_back(g_thread_pool.Submit(i, functor));
+                        futures.push_back(current_thread_pool().Submit(i, functor));
                 }
                 if constexpr (function_traits<TFunctor>::arity == 1) {
-                        futures.push_back(g_thread_pool.Submit(i, functor, i + 1));
+                        futures.push_back(current_thread_pool().Submit(i, functor, i + 1));
                 }
         }
         if constexpr (function_traits<TFunctor>::arity == 0) {
@@ -428,13 +460,13 @@ static typename std::result_of<TFunctorResult(TArg, TArg)>::type submit_for_all(
                                                                                TFunctorResult functor_result,
                                                                                const TArg& init_value) {
         std::vector<std::future<TArg>> futures;
-        futures.reserve(g_thread_pool.NumThreads());
-        for (uint32_t i = 0; i < g_thread_pool.NumThreads(); ++i) {
+        futures.reserve(current_thread_pool().NumThreads());
+        for (uint32_t i = 0; i < current_thread_pool().NumThreads(); ++i) {
                 if constexpr (function_traits<TFunctor>::arity == 0) {
-                        futures.push_back(g_thread_pool.Submit(i, functor));
+                        futures.push_back(current_thread_pool().Submit(i, functor));
                 }
                 if constexpr (function_traits<TFunctor>::arity == 1) {
-                        futures.push_back(g_thread_pool.Submit(i, functor, i + 1));
+                        futures.push_back(current_thread_pool().Submit(i, functor, i + 1));
                 }
         }
 
@@ -458,13 +490,13 @@ static typename std::result_of<TFunctorResult(TArg, TArg)>::type submit_for_all(
 template<typename TFunctor, typename TFunctorResult, typename TArg>
 static void submit_for_all(TFunctor functor, TFunctorResult functor_result, TArg& result) {
         std::vector<std::future<TArg>> futures;
-        futures.reserve(g_thread_pool.NumThreads());
-        for (uint32_t i = 0; i < g_thread_pool.NumThreads(); ++i) {
+        futures.reserve(current_thread_pool().NumThreads());
+        for (uint32_t i = 0; i < current_thread_pool().NumThreads(); ++i) {
                 if constexpr (function_traits<TFunctor>::arity == 0) {
-                        futures.push_back(g_thread_pool.Submit(i, functor));
+                        futures.push_back(current_thread_pool().Submit(i, functor));
                 }
                 if constexpr (function_traits<TFunctor>::arity == 1) {
-                        futures.push_back(g_thread_pool.Submit(i, functor, i + 1));
+                        futures.push_back(current_thread_pool().Submit(i, functor, i + 1));
                 }
         }
 
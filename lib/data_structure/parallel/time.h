@@ -8,6 +8,20 @@
 static std::mutex time_mutex;
 #define SYNC std::lock_guard<std::mutex> guard(time_mutex)
 
+namespace parallel {
+
+// seconds on a steady clock, deadlines are given as points in time of this clock
+static inline double steady_time() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// a deadline of 0 means no deadline
+static inline bool deadline_reached(double deadline) {
+        return deadline > 0 && steady_time() >= deadline;
+}
+
+}
+
 #define TIME
 
 #if defined(TIME)
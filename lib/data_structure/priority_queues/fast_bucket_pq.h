@@ -0,0 +1,284 @@
+#pragma once
+
+#include <limits>
+#include <vector>
+
+#include "data_structure/parallel/hash_table.h"
+#include "definitions.h"
+#include "macros_assertions.h"
+
+namespace parallel {
+
+struct bucket_pq_index_entry {
+        bucket_pq_index_entry()
+                :       round(0)
+                ,       position(0)
+                ,       gain(0)
+        {}
+
+        uint32_t round;
+        uint32_t position;
+        Gain gain;
+};
+
+// Index over all vertices of the graph. Clear is O(1): every entry is stamped with
+// the round it was written in and entries of previous rounds are treated as absent.
+class dense_pq_index {
+public:
+        explicit dense_pq_index(NodeID num_nodes)
+                :       m_entries(num_nodes)
+                ,       m_round(1)
+        {}
+
+        inline bool contains(NodeID node) const {
+                return m_entries[node].round == m_round;
+        }
+
+        inline void set(NodeID node, uint32_t position, Gain gain) {
+                auto& entry = m_entries[node];
+                entry.round = m_round;
+                entry.position = position;
+                entry.gain = gain;
+        }
+
+        inline void set_position(NodeID node, uint32_t position) {
+                m_entries[node].position = position;
+        }
+
+        inline uint32_t get_position(NodeID node) const {
+                return m_entries[node].position;
+        }
+
+        inline Gain get_gain(NodeID node) const {
+                return m_entries[node].gain;
+        }
+
+        inline void erase(NodeID node) {
+                m_entries[node].round = 0;
+        }
+
+        inline void clear() {
+                if (++m_round == 0) {
+                        // round counter overflowed, stamps of old rounds may become valid again
+                        for (auto& entry : m_entries) {
+                                entry.round = 0;
+                        }
+                        m_round = 1;
+                }
+        }
+
+private:
+        std::vector<bucket_pq_index_entry> m_entries;
+        uint32_t m_round;
+};
+
+// Index over the vertices touched by a local search only. Clear is linear in the
+// number of vertices inserted since the last clear.
+class sparse_pq_index {
+public:
+        explicit sparse_pq_index(NodeID)
+                :       m_entries(128)
+        {}
+
+        inline bool contains(NodeID node) const {
+                return m_entries.contains(node);
+        }
+
+        inline void set(NodeID node, uint32_t position, Gain gain) {
+                auto& entry = m_entries[node];
+                entry.position = position;
+                entry.gain = gain;
+        }
+
+        inline void set_position(NodeID node, uint32_t position) {
+                m_entries[node].position = position;
+        }
+
+        inline uint32_t get_position(NodeID node) {
+                return m_entries[node].position;
+        }
+
+        inline Gain get_gain(NodeID node) {
+                return m_entries[node].gain;
+        }
+
+        inline void erase(NodeID node) {
+                m_entries.erase(node);
+        }
+
+        inline void clear() {
+                m_entries.clear();
+        }
+
+private:
+        HashMapWithErase<NodeID, bucket_pq_index_entry, xxhash<NodeID>, true, false> m_entries;
+};
+
+// Non-virtual bucket priority queue for integer gains in [-gain_span, gain_span].
+// Buckets are stamped with the round they were last used in, so clear does not touch them.
+template <typename index_type>
+class fast_bucket_pq {
+public:
+        // larger spans are served by the generic refinement_pq
+        static constexpr EdgeWeight max_gain_span = 1 << 16;
+
+        fast_bucket_pq(EdgeWeight gain_span, NodeID num_nodes)
+                :       m_elements(0)
+                ,       m_gain_span(gain_span)
+                ,       m_max_idx(0)
+                ,       m_round(1)
+                ,       m_index(num_nodes)
+                ,       m_buckets(2 * gain_span + 1)
+        {
+                ALWAYS_ASSERT(gain_span >= 0);
+        }
+
+        fast_bucket_pq(const fast_bucket_pq&) = delete;
+        fast_bucket_pq& operator=(const fast_bucket_pq&) = delete;
+
+        inline NodeID size() const {
+                return m_elements;
+        }
+
+        inline bool empty() const {
+                return m_elements == 0;
+        }
+
+        inline void insert(NodeID node, Gain gain) {
+                ASSERT_TRUE(gain >= -m_gain_span && gain <= m_gain_span);
+                uint32_t address = gain + m_gain_span;
+                auto& elements = get_bucket(address);
+
+                if (address > m_max_idx || m_elements == 0) {
+                        m_max_idx = address;
+                }
+
+                m_index.set(node, elements.size(), gain);
+                elements.push_back(node);
+                ++m_elements;
+        }
+
+        inline Gain maxValue() const {
+                return (Gain) m_max_idx - m_gain_span;
+        }
+
+        inline NodeID maxElement() const {
+                return m_buckets[m_max_idx].elements.back();
+        }
+
+        inline NodeID deleteMax() {
+                auto& elements = m_buckets[m_max_idx].elements;
+                NodeID node = elements.back();
+                elements.pop_back();
+                m_index.erase(node);
+                --m_elements;
+
+                if (elements.empty()) {
+                        update_max_idx();
+                }
+                return node;
+        }
+
+        inline void decreaseKey(NodeID node, Gain new_gain) {
+                changeKey(node, new_gain);
+        }
+
+        inline void increaseKey(NodeID node, Gain new_gain) {
+                changeKey(node, new_gain);
+        }
+
+        inline void changeKey(NodeID node, Gain new_gain) {
+                if (m_index.get_gain(node) == new_gain) {
+                        return;
+                }
+                deleteNode(node);
+                insert(node, new_gain);
+        }
+
+        inline Gain getKey(NodeID node) {
+                return m_index.get_gain(node);
+        }
+
+        inline void deleteNode(NodeID node) {
+                ASSERT_TRUE(m_index.contains(node));
+                uint32_t position = m_index.get_position(node);
+                uint32_t address = m_index.get_gain(node) + m_gain_span;
+                auto& elements = m_buckets[address].elements;
+
+                NodeID last = elements.back();
+                elements[position] = last;
+                m_index.set_position(last, position);
+                elements.pop_back();
+
+                m_index.erase(node);
+                --m_elements;
+
+                if (elements.empty() && address == m_max_idx) {
+                        update_max_idx();
+                }
+        }
+
+        inline bool contains(NodeID node) const {
+                return m_index.contains(node);
+        }
+
+        inline void clear() {
+                m_index.clear();
+                m_elements = 0;
+                m_max_idx = 0;
+
+                if (++m_round == 0) {
+                        for (auto& bucket : m_buckets) {
+                                bucket.round = 0;
+                                bucket.elements.clear();
+                        }
+                        m_round = 1;
+                }
+        }
+
+private:
+        struct bucket {
+                bucket()
+                        :       round(0)
+                {}
+
+                uint32_t round;
+                std::vector<NodeID> elements;
+        };
+
+        NodeID m_elements;
+        EdgeWeight m_gain_span;
+        uint32_t m_max_idx; // points to the non-empty bucket with the largest gain
+        uint32_t m_round;
+        index_type m_index;
+        std::vector<bucket> m_buckets;
+
+        inline std::vector<NodeID>& get_bucket(uint32_t address) {
+                auto& b = m_buckets[address];
+                if (b.round != m_round) {
+                        b.elements.clear();
+                        b.round = m_round;
+                }
+                return b.elements;
+        }
+
+        inline void update_max_idx() {
+                if (m_elements == 0) {
+                        m_max_idx = 0;
+                        return;
+                }
+
+                // there is a non-empty bucket below, all buckets of older rounds are empty
+                while (m_max_idx != 0) {
+                        --m_max_idx;
+                        const auto& b = m_buckets[m_max_idx];
+                        if (b.round == m_round && !b.elements.empty()) {
+                                break;
+                        }
+                }
+        }
+};
+
+using dense_bucket_pq = fast_bucket_pq<dense_pq_index>;
+using sparse_bucket_pq = fast_bucket_pq<sparse_pq_index>;
+}
@@ -147,7 +147,9 @@ typedef enum {
 
 typedef enum {
         BIPARTITION_BFS, 
-	BIPARTITION_FM
+	BIPARTITION_FM,
+        BIPARTITION_RANDOM,
+        BIPARTITION_SPECTRAL
 } BipartitionAlgorithm ;
 
 typedef enum {
@@ -176,7 +178,8 @@ typedef enum {
 
 enum class ParallelLPType {
         QUEUE,
-        NO_QUEUE
+        NO_QUEUE,
+        ASYNC_QUEUE
 };
 
 enum class BlockSizeUnit {
@@ -197,5 +200,10 @@ enum class MultitryKwayLoopStoppingRule {
         QUANTILE
 };
 
+enum class RefinementObjective {
+        CUT,
+        COMMUNICATION_VOLUME
+};
+
 #endif
 
@@ -223,4 +223,82 @@ void graph_io::writePartition(graph_access & G, std::string filename) {
         f.close();
 }
 
+// Every line of a delta file describes one change, node ids are 1-based as in the METIS format:
+//   a u v [w]   add the edge {u, v} with weight w (default 1)
+//   d u v       remove the edge {u, v}
+//   w u c       set the weight of node u to c
+//   n [c]       append a new node with weight c (default 1)
+int graph_io::readGraphDelta(graph_delta& delta, std::string filename) {
+        std::string line;
+
+        // open file for reading
+        std::ifstream in(filename.c_str());
+        if (!in) {
+                std::cerr << "Error opening " << filename << std::endl;
+                return 1;
+        }
+
+        size_t line_number = 0;
+        while (std::getline(in, line)) {
+                ++line_number;
+                if (line.empty() || line[0] == '%') { //Comment
+                        continue;
+                }
+
+                std::stringstream ss(line);
+                char type;
+                ss >> type;
+
+                bool ok = true;
+                switch (type) {
+                        case 'a': {
+                                long u = 0, v = 0, w = 1;
+                                ss >> u >> v;
+                                ok = !ss.fail() && u > 0 && v > 0 && u != v;
+                                long weight;
+                                if (ss >> weight) {
+                                        w = weight;
+                                }
+                                ok = ok && w > 0;
+                                delta.added_edges.push_back({(NodeID) u - 1, (NodeID) v - 1, (EdgeWeight) w});
+                                break;
+                        }
+                        case 'd': {
+                                long u = 0, v = 0;
+                                ss >> u >> v;
+                                ok = !ss.fail() && u > 0 && v > 0;
+                                delta.removed_edges.push_back({(NodeID) u - 1, (NodeID) v - 1, 0});
+                                break;
+                        }
+                        case 'w': {
+                                long u = 0, c = 0;
+                                ss >> u >> c;
+                                ok = !ss.fail() && u > 0 && c > 0;
+                                delta.node_weights.emplace_back((NodeID) u - 1, (NodeWeight) c);
+                                break;
+                        }
+                        case 'n': {
+                                long c = 1;
+                                long weight;
+                                if (ss >> weight) {
+                                        c = weight;
+                                }
+                                ok = c > 0;
+                                delta.new_node_weights.push_back((NodeWeight) c);
+                                break;
+                        }
+                        default:
+                                ok = false;
+                }
+
+                if (!ok) {
+                        std::cerr << "Error in " << filename << " at line " << line_number << ": " << line << std::endl;
+                        return 1;
+                }
+        }
+
+        in.close();
+        return 0;
+}
+
 
@@ -33,6 +33,7 @@
 
 #include "definitions.h"
 #include "data_structure/graph_access.h"
+#include "data_structure/graph_delta.h"
 
 class graph_io {
         public:
@@ -54,6 +55,9 @@ class graph_io {
                 static 
                 void writePartition(graph_access& G, std::string filename);
 
+                static
+                int readGraphDelta(graph_delta& delta, std::string filename);
+
                 template<typename vectortype> 
                 static void writeVector(std::vector<vectortype> & vec, std::string filename);
 
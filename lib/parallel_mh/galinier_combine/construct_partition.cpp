@@ -20,7 +20,12 @@
  * this program.  If not, see <http://www.gnu.org/licenses/>.
  *****************************************************************************/
 
+#include <atomic>
+
 #include "construct_partition.h"
+#include "data_structure/parallel/algorithm.h"
+#include "data_structure/parallel/atomics.h"
+#include "data_structure/parallel/thread_pool.h"
 #include "graph_partitioner.h"
 #include "quality_metrics.h"
 #include "random_functions.h"
@@ -28,6 +33,7 @@
 #include "uncoarsening/refinement/cycle_improvements/cycle_refinement.h"
 #include "uncoarsening/refinement/mixed_refinement.h"
 #include "uncoarsening/refinement/refinement.h"
+#include "uncoarsening/refinement/tabu_search/parallel_tabu_search.h"
 #include "uncoarsening/refinement/tabu_search/tabu_search.h"
 
 
@@ -120,6 +126,96 @@ void construct_partition::construct_starting_from_partition( PartitionConfig & c
 	}
 }
 
+void construct_partition::parallel_construct_starting_from_partition( PartitionConfig & config, graph_access & G) {
+        const PartitionID unassigned = config.k;
+        const uint32_t num_threads   = parallel::current_thread_pool().NumThreads() + 1;
+
+        // like the sequential version, block weights count the nodes of a block
+        std::vector< parallel::AtomicWrapper<PartitionID> > partition(G.number_of_nodes());
+        std::vector< std::vector< std::vector<NodeID> > > thread_frontiers(num_threads, std::vector< std::vector<NodeID> >(config.k));
+        std::vector< std::vector<NodeWeight> > thread_weights(num_threads, std::vector<NodeWeight>(config.k, 0));
+        parallel::parallel_for_index(NodeID(0), G.number_of_nodes(), [&](NodeID node, uint32_t thread_id) {
+                PartitionID block = G.getPartitionIndex(node);
+                partition[node].store(block, std::memory_order_relaxed);
+                if( block == unassigned ) {
+                        return;
+                }
+
+                thread_weights[thread_id][block]++;
+                forall_out_edges(G, e, node) {
+                        NodeID target = G.getEdgeTarget(e);
+                        if( G.getPartitionIndex(target) == unassigned ) {
+                                thread_frontiers[thread_id][block].push_back(target);
+                        }
+                } endfor
+        });
+
+        // every block is handled by one thread at a time
+        auto for_all_blocks = [&](auto functor) {
+                std::atomic<PartitionID> next_block(0);
+                parallel::submit_for_all([&]() {
+                        PartitionID block;
+                        while( (block = next_block.fetch_add(1, std::memory_order_relaxed)) < config.k ) {
+                                functor(block);
+                        }
+                });
+        };
+
+        std::vector< std::vector<NodeID> > frontiers(config.k);
+        std::vector< NodeWeight > block_weights(config.k, 0);
+        for_all_blocks([&](PartitionID block) {
+                for( uint32_t id = 0; id < num_threads; id++) {
+                        block_weights[block] += thread_weights[id][block];
+                        frontiers[block].insert(frontiers[block].end(), thread_frontiers[id][block].begin(), thread_frontiers[id][block].end());
+                }
+        });
+
+        // every round adds one breadth first search layer to all blocks that are not full
+        const NodeWeight max_block_weight = ceil(G.number_of_nodes() / (double)config.k);
+        std::atomic<NodeID> assigned_in_round(0);
+        do {
+                assigned_in_round.store(0, std::memory_order_relaxed);
+                for_all_blocks([&](PartitionID block) {
+                        std::vector<NodeID> next_frontier;
+                        NodeID assigned = 0;
+                        for( NodeID node : frontiers[block] ) {
+                                if( block_weights[block] >= max_block_weight ) {
+                                        break;
+                                }
+
+                                PartitionID expected = unassigned;
+                                if( !partition[node].compare_exchange_strong(expected, block, std::memory_order_acq_rel) ) {
+                                        continue;
+                                }
+                                block_weights[block]++;
+                                assigned++;
+
+                                forall_out_edges(G, e, node) {
+                                        NodeID target = G.getEdgeTarget(e);
+                                        if( partition[target].load(std::memory_order_relaxed) == unassigned ) {
+                                                next_frontier.push_back(target);
+                                        }
+                                } endfor
+                        }
+                        frontiers[block].swap(next_frontier);
+                        assigned_in_round.fetch_add(assigned, std::memory_order_relaxed);
+                });
+        } while( assigned_in_round.load(std::memory_order_relaxed) > 0 );
+
+        std::atomic<bool> complete(true);
+        parallel::parallel_for_index(NodeID(0), G.number_of_nodes(), [&](NodeID node) {
+                PartitionID block = partition[node].load(std::memory_order_relaxed);
+                G.setPartitionIndex(node, block);
+                if( block == unassigned ) {
+                        complete.store(false, std::memory_order_relaxed);
+                }
+        });
+
+        if( !complete.load() ) {
+                construct_starting_from_partition( config, G );
+        }
+}
+
 void construct_partition::createIndividuum( PartitionConfig & config, graph_access & G, Individuum & ind, bool output) {
         std::cout <<  "creating individuum "  << std::endl;
         forall_nodes(G, node) {
@@ -135,16 +231,23 @@ void construct_partition::createIndividuum( PartitionConfig & config, graph_acce
                 G.setPartitionIndex(node, block);
         }
 
-        construct_starting_from_partition( config, G);
-
-	complete_boundary boundary(&G);
-	boundary.build();
-
-	tabu_search ts;
 	PartitionConfig copy = config;
 	copy.maxIter         = G.number_of_nodes();
 
-	ts.perform_refinement( copy, G, boundary);
+        if( config.parallel_combine_operators ) {
+                parallel_construct_starting_from_partition( config, G);
+
+                parallel::tabu_search ts;
+                ts.perform_refinement( copy, G);
+        } else {
+                construct_starting_from_partition( config, G);
+
+                complete_boundary boundary(&G);
+                boundary.build();
+
+                tabu_search ts;
+                ts.perform_refinement( copy, G, boundary);
+        }
 
 	int* partition_map = new int[G.number_of_nodes()];
 	forall_nodes(G, node) {
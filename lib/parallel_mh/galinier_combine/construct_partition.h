@@ -33,6 +33,11 @@ public:
         virtual ~construct_partition();
 
         void construct_starting_from_partition( PartitionConfig & config, graph_access & G);
+
+        // grows all blocks concurrently by breadth first search, nodes are claimed by compare and swap.
+        // the nodes that are left when the blocks are full or can not grow anymore are assigned sequentially
+        void parallel_construct_starting_from_partition( PartitionConfig & config, graph_access & G);
+
         void createIndividuum( PartitionConfig & config, graph_access & G, 
                                Individuum & ind, bool output); 
 };
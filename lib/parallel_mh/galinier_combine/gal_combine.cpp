@@ -20,17 +20,21 @@
  * this program.  If not, see <http://www.gnu.org/licenses/>.
  *****************************************************************************/
 
+#include <atomic>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 
 #include "construct_partition.h"
+#include "data_structure/parallel/algorithm.h"
+#include "data_structure/parallel/thread_pool.h"
 #include "gal_combine.h"
 #include "graph_partitioner.h"
 #include "random_functions.h"
 #include "uncoarsening/refinement/cycle_improvements/cycle_refinement.h"
 #include "uncoarsening/refinement/mixed_refinement.h"
 #include "uncoarsening/refinement/refinement.h"
+#include "uncoarsening/refinement/tabu_search/parallel_tabu_search.h"
 #include "uncoarsening/refinement/tabu_search/tabu_search.h"
 
 gal_combine::gal_combine() {
@@ -49,14 +53,35 @@ gal_combine::~gal_combine() {
 void gal_combine::perform_gal_combine( PartitionConfig & config, graph_access & G) {
         //first greedily compute a matching of the partitions
         std::vector< std::unordered_map<PartitionID, unsigned> > counters(config.k);
-        forall_nodes(G, node) {
-                //boundary_pair bp;
-                if(counters[G.getPartitionIndex(node)].find(G.getSecondPartitionIndex(node)) != counters[G.getPartitionIndex(node)].end()) {
-                        counters[G.getPartitionIndex(node)][G.getSecondPartitionIndex(node)] += 1;
-                } else {
-                        counters[G.getPartitionIndex(node)][G.getSecondPartitionIndex(node)] = 1;
-                }
-        } endfor
+        if( config.parallel_combine_operators ) {
+                // every thread counts the overlaps of the nodes it scans, the counters are merged per block
+                const uint32_t num_threads = parallel::current_thread_pool().NumThreads() + 1;
+                std::vector< std::vector< std::unordered_map<PartitionID, unsigned> > > thread_counters(num_threads, counters);
+                parallel::parallel_for_index(NodeID(0), G.number_of_nodes(), [&](NodeID node, uint32_t thread_id) {
+                        thread_counters[thread_id][G.getPartitionIndex(node)][G.getSecondPartitionIndex(node)] += 1;
+                });
+
+                std::atomic<PartitionID> next_block(0);
+                parallel::submit_for_all([&]() {
+                        PartitionID block;
+                        while( (block = next_block.fetch_add(1, std::memory_order_relaxed)) < config.k ) {
+                                for( uint32_t id = 0; id < num_threads; id++) {
+                                        for( auto & counter : thread_counters[id][block] ) {
+                                                counters[block][counter.first] += counter.second;
+                                        }
+                                }
+                        }
+                });
+        } else {
+                forall_nodes(G, node) {
+                        //boundary_pair bp;
+                        if(counters[G.getPartitionIndex(node)].find(G.getSecondPartitionIndex(node)) != counters[G.getPartitionIndex(node)].end()) {
+                                counters[G.getPartitionIndex(node)][G.getSecondPartitionIndex(node)] += 1;
+                        } else {
+                                counters[G.getPartitionIndex(node)][G.getSecondPartitionIndex(node)] = 1;
+                        }
+                } endfor
+        }
 
         std::vector< PartitionID > permutation(config.k);
         for( unsigned i = 0; i < permutation.size(); i++) {
@@ -85,18 +110,26 @@ void gal_combine::perform_gal_combine( PartitionConfig & config, graph_access &
                 }
         }
 
-        std::vector<bool> blocked_vertices(G.number_of_nodes(), false);
-        forall_nodes(G, node) {
-                if( bipartite_matching[G.getPartitionIndex(node)] == G.getSecondPartitionIndex(node) ){
-                        blocked_vertices[node] = true;
-                } else {
-                        // we will reassign this vertex since the partitions do not agree on it
-                        G.setPartitionIndex(node, config.k); 
-                }
-        } endfor
-
         construct_partition cp;
-        cp.construct_starting_from_partition( config, G );
+        if( config.parallel_combine_operators ) {
+                parallel::parallel_for_index(NodeID(0), G.number_of_nodes(), [&](NodeID node) {
+                        if( bipartite_matching[G.getPartitionIndex(node)] != G.getSecondPartitionIndex(node) ){
+                                G.setPartitionIndex(node, config.k); 
+                        }
+                });
+                cp.parallel_construct_starting_from_partition( config, G );
+        } else {
+                std::vector<bool> blocked_vertices(G.number_of_nodes(), false);
+                forall_nodes(G, node) {
+                        if( bipartite_matching[G.getPartitionIndex(node)] == G.getSecondPartitionIndex(node) ){
+                                blocked_vertices[node] = true;
+                        } else {
+                                // we will reassign this vertex since the partitions do not agree on it
+                                G.setPartitionIndex(node, config.k); 
+                        }
+                } endfor
+                cp.construct_starting_from_partition( config, G );
+        }
 
         refinement* refine = new mixed_refinement();
 
@@ -105,11 +138,16 @@ void gal_combine::perform_gal_combine( PartitionConfig & config, graph_access &
         PartitionConfig copy = config;
         copy.upper_bound_partition = (1+epsilon)*ceil(config.work_load/(double)config.k);
 
-        complete_boundary boundary(&G);
-        boundary.build();
+        if( config.parallel_combine_operators ) {
+                parallel::tabu_search ts;
+                ts.perform_refinement( copy, G);
+        } else {
+                complete_boundary boundary(&G);
+                boundary.build();
 
-        tabu_search ts;
-        ts.perform_refinement( copy, G, boundary);
+                tabu_search ts;
+                ts.perform_refinement( copy, G, boundary);
+        }
         
         //now obtain the quotient graph
         complete_boundary boundary2(&G);
@@ -121,8 +159,9 @@ void gal_combine::perform_gal_combine( PartitionConfig & config, graph_access &
         refine->perform_refinement( copy, G, boundary2);
 
         copy = config;
+        copy.parallel_cycle_refinement = config.parallel_combine_operators;
         cycle_refinement cr;
-        cr.perform_refinement(config, G, boundary2);
+        cr.perform_refinement(copy, G, boundary2);
         delete refine;
 
         
@@ -21,12 +21,16 @@
  *****************************************************************************/
 
 #include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <iostream>
 #include <math.h>
+#ifndef KAFFPAE_THREADS
 #include <mpi.h>
+#endif
 #include <sstream>
 
+#include "data_structure/parallel/thread_pool.h"
 #include "diversifyer.h"
 #include "galinier_combine/gal_combine.h"
 #include "graph_partitioner.h"
@@ -135,6 +139,10 @@ void population::insert(graph_access & G, Individuum & ind) {
 
         m_no_partition_calls++;
         if(m_internal_population.size() < m_population_size) {
+                m_cut_edge_sets.emplace_back(ind.cut_edges->begin(), ind.cut_edges->end());
+                // only the compressed cut edges are kept
+                delete ind.cut_edges;
+                ind.cut_edges = NULL;
                 m_internal_population.push_back(ind);
         } else {
                 EdgeWeight worst_objective = 0;
@@ -149,33 +157,32 @@ void population::insert(graph_access & G, Individuum & ind) {
                         return; // do nothing
                 }
                 //else measure similarity
+                parallel::compressed_edge_set ind_cut_edges(ind.cut_edges->begin(), ind.cut_edges->end());
+                delete ind.cut_edges;
+                ind.cut_edges = NULL;
+
+                std::vector<unsigned> similarity(m_internal_population.size(), std::numeric_limits<unsigned>::max());
+                auto measure = [&](unsigned i) {
+                        if(m_internal_population[i].objective >= ind.objective) {
+                                similarity[i] = m_cut_edge_sets[i].symmetric_difference_size(ind_cut_edges);
+                        }
+                };
+                // the individuals are compared concurrently
+                std::atomic<unsigned> next_idx(0);
+                parallel::submit_for_all([&]() {
+                        for( unsigned i = next_idx.fetch_add(1, std::memory_order_relaxed);
+                             i < m_internal_population.size();
+                             i = next_idx.fetch_add(1, std::memory_order_relaxed)) {
+                                measure(i);
+                        }
+                });
+
                 unsigned max_similarity = std::numeric_limits<unsigned>::max();
                 unsigned max_similarity_idx = 0;
                 for( unsigned i = 0; i < m_internal_population.size(); i++) {
-                        if(m_internal_population[i].objective >= ind.objective) {
-                                //now measure
-				int diff_size = m_internal_population[i].cut_edges->size() + ind.cut_edges->size();
-                                std::vector<EdgeID> output_diff(diff_size,std::numeric_limits<EdgeID>::max());
-
-                                set_symmetric_difference(m_internal_population[i].cut_edges->begin(),
-                                                         m_internal_population[i].cut_edges->end(),
-                                                         ind.cut_edges->begin(),
-                                                         ind.cut_edges->end(),
-                                                         output_diff.begin());
-
-                                unsigned similarity = 0;
-                                for( unsigned j = 0; j < output_diff.size(); j++) {
-                                        if(output_diff[j] < std::numeric_limits<EdgeID>::max()) {
-                                                similarity++;
-                                        } else {
-                                                break;
-                                        }
-                                }
-
-                                if( similarity < max_similarity) {
-                                        max_similarity     = similarity;
-                                        max_similarity_idx = i;
-                                }
+                        if( similarity[i] < max_similarity) {
+                                max_similarity     = similarity[i];
+                                max_similarity_idx = i;
                         }
                 }         
 
@@ -183,6 +190,7 @@ void population::insert(graph_access & G, Individuum & ind) {
                 delete m_internal_population[max_similarity_idx].cut_edges;
 
                 m_internal_population[max_similarity_idx] = ind;
+                m_cut_edge_sets[max_similarity_idx]       = std::move(ind_cut_edges);
         }
 }
 
@@ -194,6 +202,10 @@ void population::replace(Individuum & in, Individuum & out) {
                         delete[] (m_internal_population[i].partition_map);
                         delete m_internal_population[i].cut_edges;
 
+                        m_cut_edge_sets[i]       = parallel::compressed_edge_set(out.cut_edges->begin(),
+                                                                                 out.cut_edges->end());
+                        delete out.cut_edges;
+                        out.cut_edges = NULL;
                         m_internal_population[i] = out;
                         break;
                 }
@@ -270,9 +282,11 @@ void population::combine_cross(const PartitionConfig & partition_config,
         lowerbound     = std::max(2, lowerbound);
         int kfactor    = random_functions::nextInt(lowerbound,4*config.k);
 
+#ifndef KAFFPAE_THREADS
         if( config.mh_cross_combine_original_k ) {
                 MPI::COMM_WORLD.Bcast(&kfactor, 1, MPI_INT, 0);
         }
+#endif
 
         unsigned larger_imbalance = random_functions::nextInt(config.epsilon,25);
         double epsilon = larger_imbalance/100.0;
@@ -348,6 +362,7 @@ void population::extinction( ) {
 
         m_internal_population.clear();
         m_internal_population.resize(0);
+        m_cut_edge_sets.clear();
 }
 
 void population::get_two_random_individuals(Individuum & first, Individuum & second) {
@@ -431,8 +446,12 @@ void population::apply_fittest( graph_access & G, EdgeWeight & objective ) {
 }
 
 void population::print() {
+#ifndef KAFFPAE_THREADS
         int rank = MPI::COMM_WORLD.Get_rank();
         std::cout <<  "rank " <<  rank << " fingerprint ";
+#else
+        std::cout <<  "fingerprint ";
+#endif
 
         for( unsigned i = 0; i < m_internal_population.size(); i++) {
                 std::cout <<  m_internal_population[i].objective << " ";
@@ -26,13 +26,14 @@
 #include <sstream>
 
 #include "data_structure/graph_access.h"
+#include "data_structure/parallel/compressed_edge_set.h"
 #include "partition_config.h"
 #include "timer.h"
 
 struct Individuum {
         int* partition_map;
         EdgeWeight objective;
-        std::vector<EdgeID>* cut_edges; //sorted
+        std::vector<EdgeID>* cut_edges; //sorted, released once the individual is inserted into a population
 };
 
 struct ENC {
@@ -98,6 +99,8 @@ class population {
                 unsigned                m_no_partition_calls;
                 unsigned 		m_population_size;
                 std::vector<Individuum> m_internal_population;
+                // compressed cut edges of m_internal_population[i], used for the similarity in insert
+                std::vector<parallel::compressed_edge_set> m_cut_edge_sets;
                 std::vector< std::vector< unsigned int > > m_vertex_ENCs;
                 std::vector< ENC > m_ENCs;
 
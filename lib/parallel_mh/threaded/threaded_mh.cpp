@@ -0,0 +1,250 @@
+#include "data_structure/parallel/thread_context.h"
+#include "data_structure/parallel/thread_pool.h"
+#include "parallel_mh/diversifyer.h"
+#include "parallel_mh/galinier_combine/construct_partition.h"
+#include "parallel_mh/threaded/threaded_mh.h"
+#include "quality_metrics.h"
+#include "random_functions.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+namespace parallel {
+
+threaded_mh::threaded_mh(uint32_t num_islands, uint32_t num_threads)
+        :       m_num_islands(std::max<uint32_t>(num_islands, 1))
+        ,       m_num_threads(std::max(num_threads, m_num_islands))
+        ,       m_max_num_pushes(m_num_islands > 2 ? ceil(log2(m_num_islands)) : 1)
+        ,       m_time_limit(0)
+        ,       m_mailboxes(m_num_islands)
+        ,       m_best_objective(std::numeric_limits<EdgeWeight>::max())
+{}
+
+void threaded_mh::perform_partitioning(const PartitionConfig& config, graph_access& G) {
+        m_time_limit = config.time_limit;
+        m_best_map.resize(G.number_of_nodes());
+        m_t.restart();
+
+        std::vector<std::thread> islands;
+        islands.reserve(m_num_islands - 1);
+        // the islands use the output settings of this thread
+        thread_context context = t_thread_context;
+        for (uint32_t id = 1; id < m_num_islands; ++id) {
+                islands.emplace_back([&, id, context]() {
+                        scoped_thread_context scope(context);
+                        run_island(config, G, id);
+                });
+        }
+        run_island(config, G, 0);
+        for (auto& island : islands) {
+                island.join();
+        }
+
+        forall_nodes(G, node) {
+                G.setPartitionIndex(node, m_best_map[node]);
+        } endfor
+}
+
+void threaded_mh::run_island(const PartitionConfig& shared_config, graph_access& G, uint32_t id) {
+        // the island only uses its share of the threads, both for the parallel components and for
+        // the recursive bipartitioning of the initial partitioning. Its pool is not pinned, since
+        // the islands run side by side.
+        PartitionConfig config = shared_config;
+        config.num_threads = island_threads(id);
+
+        TThreadPoolWithTaskQueuePerThread pool(config.num_threads - 1, false);
+        thread_context context = t_thread_context;
+        context.pool        = &pool;
+        context.pin_threads = false;
+        scoped_thread_context scope(context);
+
+        srand(config.seed * m_num_islands + id);
+        random_functions::setSeed(config.seed * m_num_islands + id);
+
+        // the island only needs its own partition arrays
+        graph_access island_G;
+        G.share_topology(island_G);
+
+        PartitionConfig ini_working_config = config;
+        population island(ini_working_config);
+
+        timer t;
+        Individuum first_one;
+        if (!ini_working_config.mh_easy_construction) {
+                island.createIndividuum(ini_working_config, island_G, first_one, true);
+        } else {
+                construct_partition cp;
+                cp.createIndividuum(ini_working_config, island_G, first_one, true);
+        }
+        island.insert(island_G, first_one);
+
+        uint32_t population_size = initial_population_size(ini_working_config, t.elapsed());
+        island.set_pool_size(population_size);
+        ini_working_config.mh_pool_size = population_size;
+
+        island_state state;
+        state.prev_best_objective = std::numeric_limits<EdgeWeight>::max();
+        state.cur_num_pushes = 0;
+        state.allready_send_to.assign(m_num_islands, false);
+        state.allready_send_to[id] = true;
+
+        do {
+                PartitionConfig working_config = config;
+                working_config.graph_allready_partitioned = false;
+                if (!config.strong) {
+                        working_config.no_new_initial_partitioning = false;
+                }
+                working_config.mh_pool_size = ini_working_config.mh_pool_size;
+
+                perform_local_partitioning(working_config, island_G, island);
+
+                if (m_t.elapsed() <= m_time_limit && m_num_islands > 1) {
+                        push_best(id, island_G, island, state);
+                        recv_incoming(id, working_config, island_G, island, state);
+                }
+        } while (m_t.elapsed() <= m_time_limit);
+
+        Individuum best;
+        island.get_best_individuum(best);
+        std::lock_guard<std::mutex> lock(m_best_mutex);
+        if (best.objective < m_best_objective) {
+                m_best_objective = best.objective;
+                std::copy(best.partition_map, best.partition_map + G.number_of_nodes(), m_best_map.begin());
+        }
+}
+
+uint32_t threaded_mh::island_threads(uint32_t id) const {
+        return m_num_threads / m_num_islands + (id < m_num_threads % m_num_islands ? 1 : 0);
+}
+
+uint32_t threaded_mh::initial_population_size(const PartitionConfig& config, double time_spent) const {
+        double fraction_to_spend_for_IP = m_time_limit / config.mh_initial_population_fraction;
+        uint32_t population_size = ceil(fraction_to_spend_for_IP / std::max(time_spent, 1e-6));
+        population_size = std::max(3u, population_size);
+        return std::min(config.mh_easy_construction ? 50u : 100u, population_size);
+}
+
+void threaded_mh::perform_local_partitioning(PartitionConfig& working_config, graph_access& G,
+                                             population& island) {
+        if (working_config.mh_diversify) {
+                diversifyer div;
+                div.diversify(working_config);
+        }
+
+        for (unsigned i = 0; i < working_config.local_partitioning_repetitions; ++i) {
+                Individuum output;
+                if (island.is_full() && !working_config.mh_disable_combine) {
+                        int decision = random_functions::nextInt(0, 9);
+                        if (decision < working_config.mh_flip_coin) {
+                                island.mutate_random(working_config, G, output);
+                                island.insert(G, output);
+                        } else if (random_functions::nextInt(0, 5) <= 4) {
+                                Individuum first_rnd;
+                                Individuum second_rnd;
+                                if (working_config.mh_enable_tournament_selection) {
+                                        island.get_two_individuals_tournament(first_rnd, second_rnd);
+                                } else {
+                                        island.get_two_random_individuals(first_rnd, second_rnd);
+                                }
+                                island.combine(working_config, G, first_rnd, second_rnd, output);
+
+                                // occasionally a galinier combine result replaces the worse parent
+                                if (working_config.mh_enable_gal_combine && random_functions::nextInt(0, 100) == 23) {
+                                        island.replace(first_rnd.objective > second_rnd.objective ? first_rnd : second_rnd,
+                                                       output);
+                                } else {
+                                        island.insert(G, output);
+                                }
+                        } else if (!working_config.mh_disable_cross_combine) {
+                                Individuum selected;
+                                island.get_one_individual_tournament(selected);
+                                island.combine_cross(working_config, G, selected, output);
+                                island.insert(G, output);
+                        }
+                } else {
+                        if (island.is_full()) {
+                                island.mutate_random(working_config, G, output);
+                        } else if (!working_config.mh_easy_construction) {
+                                island.createIndividuum(working_config, G, output, true);
+                        } else {
+                                construct_partition cp;
+                                cp.createIndividuum(working_config, G, output, true);
+                        }
+                        island.insert(G, output);
+                }
+
+                if (m_t.elapsed() > m_time_limit) {
+                        break;
+                }
+        }
+}
+
+void threaded_mh::push_best(uint32_t id, graph_access& G, population& island, island_state& state) {
+        Individuum best_ind;
+        island.get_best_individuum(best_ind);
+
+        if (best_ind.objective < state.prev_best_objective) {
+                state.prev_best_objective = best_ind.objective;
+                std::fill(state.allready_send_to.begin(), state.allready_send_to.end(), false);
+                state.allready_send_to[id] = true;
+                state.cur_num_pushes = 0;
+                std::cout << "island " << id << ": pool improved " << best_ind.objective << std::endl;
+        }
+
+        if (state.cur_num_pushes > m_max_num_pushes
+            || std::all_of(state.allready_send_to.begin(), state.allready_send_to.end(), [](bool sent) { return sent; })) {
+                return;
+        }
+
+        uint32_t target = id;
+        while (state.allready_send_to[target]) {
+                target = random_functions::nextInt(0, m_num_islands - 1);
+        }
+
+        // the map is copied once, the receiver builds its own individual from it
+        auto map = std::make_shared<const std::vector<int>>(best_ind.partition_map,
+                                                            best_ind.partition_map + G.number_of_nodes());
+        m_mailboxes[target].push(std::make_pair(id, std::move(map)));
+
+        ++state.cur_num_pushes;
+        state.allready_send_to[target] = true;
+}
+
+void threaded_mh::recv_incoming(uint32_t id, const PartitionConfig& config, graph_access& G, population& island,
+                                island_state& state) {
+        quality_metrics qm;
+        std::pair<uint32_t, migrant> message;
+        while (m_mailboxes[id].try_pop(message)) {
+                const std::vector<int>& map = *message.second;
+
+                Individuum out;
+                out.partition_map = new int[G.number_of_nodes()];
+                out.cut_edges = new std::vector<EdgeID>();
+                std::copy(map.begin(), map.end(), out.partition_map);
+
+                forall_nodes(G, node) {
+                        forall_out_edges(G, e, node) {
+                                if (out.partition_map[node] != out.partition_map[G.getEdgeTarget(e)]) {
+                                        out.cut_edges->push_back(e);
+                                }
+                        } endfor
+                } endfor
+
+                out.objective = qm.objective(config, G, out.partition_map);
+                island.insert(G, out);
+
+                if (out.objective < state.prev_best_objective) {
+                        state.prev_best_objective = out.objective;
+                        std::fill(state.allready_send_to.begin(), state.allready_send_to.end(), false);
+                        state.allready_send_to[id] = true;
+                        state.cur_num_pushes = 0;
+                }
+
+                // the sender does not need it back
+                state.allready_send_to[message.first] = true;
+        }
+}
+
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "data_structure/graph_access.h"
+#include "parallel_mh/population.h"
+#include "partition_config.h"
+#include "timer.h"
+
+#include <tbb/concurrent_queue.h>
+
+namespace parallel {
+
+// Evolutionary partitioning with one island per thread. All islands share the topology of the input
+// graph, every island only owns its population and the partition arrays of its view of the graph.
+// Islands exchange their best individuals through mailboxes instead of MPI messages.
+// The threads are split evenly between the islands. Every island runs the parallel multilevel components
+// on its own pool of that size, which it installs in its thread_context, so the islands never wait for
+// each other.
+class threaded_mh {
+public:
+        threaded_mh(uint32_t num_islands, uint32_t num_threads);
+
+        void perform_partitioning(const PartitionConfig& config, graph_access& G);
+
+private:
+        using migrant = std::shared_ptr<const std::vector<int>>;
+
+        // migration state of one island, corresponds to the exchanger of the MPI version
+        struct island_state {
+                EdgeWeight prev_best_objective;
+                uint32_t cur_num_pushes;
+                std::vector<bool> allready_send_to;
+        };
+
+        void run_island(const PartitionConfig& config, graph_access& G, uint32_t id);
+
+        // number of threads of island id, including the thread of the island itself
+        uint32_t island_threads(uint32_t id) const;
+
+        uint32_t initial_population_size(const PartitionConfig& config, double time_spent) const;
+
+        void perform_local_partitioning(PartitionConfig& config, graph_access& G, population& island);
+
+        void push_best(uint32_t id, graph_access& G, population& island, island_state& state);
+
+        void recv_incoming(uint32_t id, const PartitionConfig& config, graph_access& G, population& island,
+                           island_state& state);
+
+        const uint32_t m_num_islands;
+        const uint32_t m_num_threads;
+        const uint32_t m_max_num_pushes;
+        timer m_t;
+        double m_time_limit;
+
+        std::vector<tbb::concurrent_queue<std::pair<uint32_t, migrant>>> m_mailboxes;
+
+        std::mutex m_best_mutex;
+        EdgeWeight m_best_objective;
+        std::vector<PartitionID> m_best_map;
+};
+
+}
@@ -231,7 +231,7 @@ uint32_t size_constraint_label_propagation::parallel_label_propagation(const Par
                                                                        std::vector<parallel::AtomicWrapper<char>> new_active
 ) {
         std::vector<std::future<std::pair<uint32_t, uint32_t>>> futures;
-        futures.reserve(parallel::g_thread_pool.NumThreads());
+        futures.reserve(parallel::current_thread_pool().NumThreads());
         uint32_t num_changed_label_all = 0;
 
         std::vector<std::vector<PartitionID>> hash_maps(config.num_threads);
@@ -282,6 +282,13 @@ uint32_t size_constraint_label_propagation::parallel_label_propagation(const Par
                                         neighbor_parts.reserve(G.getNodeDegree(node));
                                         forall_out_edges(G, e, node) {
                                                 NodeID target = G.getEdgeTarget(e);
+                                                // clusters never cross blocks of an existing partition
+                                                if ((config.graph_allready_partitioned
+                                                     && G.getPartitionIndex(target) != G.getPartitionIndex(node))
+                                                    || (config.combine
+                                                        && G.getSecondPartitionIndex(target) != G.getSecondPartitionIndex(node))) {
+                                                        continue;
+                                                }
                                                 NodeID cluster = cluster_id[target];
                                                 if (hash_map[cluster] == 0) {
                                                         neighbor_parts.push_back(cluster);
@@ -304,8 +311,6 @@ uint32_t size_constraint_label_propagation::parallel_label_propagation(const Par
 
                                                 if ((cur_value > max_value || (cur_value == max_value && rnd.bit())) &&
                                                         (cur_cluster_size + node_weight < block_upperbound || cur_block == my_block)) {
-                                                        ALWAYS_ASSERT(!config.graph_allready_partitioned);
-                                                        ALWAYS_ASSERT(!config.combine);
                                                         max_value = cur_value;
                                                         max_block = cur_block;
                                                         max_cluster_size = cur_cluster_size;
@@ -351,9 +356,9 @@ uint32_t size_constraint_label_propagation::parallel_label_propagation(const Par
                         return std::make_pair(num_changed_label, num_active);
                 };
 
-                for (size_t i = 0; i < parallel::g_thread_pool.NumThreads(); ++i) {
-                        futures.push_back(parallel::g_thread_pool.Submit(i, process, i + 1));
-//                        futures.push_back(parallel::g_thread_pool.Submit(process, i + 1));
+                for (size_t i = 0; i < parallel::current_thread_pool().NumThreads(); ++i) {
+                        futures.push_back(parallel::current_thread_pool().Submit(i, process, i + 1));
+//                        futures.push_back(parallel::current_thread_pool().Submit(process, i + 1));
                 }
 
                 uint32_t num_active = 0;
@@ -514,7 +519,7 @@ void size_constraint_label_propagation::parallel_label_propagation(const Partiti
                 permutation.emplace_back(node, G.getNodeDegree(node));
         } endfor
 
-        parallel::g_thread_pool.Clear();
+        parallel::current_thread_pool().Clear();
         parallel::Unpin();
         {
                 CLOCK_START;
@@ -524,7 +529,7 @@ void size_constraint_label_propagation::parallel_label_propagation(const Partiti
                 CLOCK_END("Sort");
         }
         parallel::PinToCore(0);
-        parallel::g_thread_pool.Resize(config.num_threads - 1);
+        parallel::current_thread_pool().Resize(config.num_threads - 1);
 
         {
                 CLOCK_START;
@@ -124,6 +124,8 @@ void coarsening::perform_coarsening(const PartitionConfig & partition_config, gr
 
                 level++;
 
+                // the deadline is not checked here, initial partitioning of a barely coarsened graph
+                // would take much longer than the remaining levels
         } while (contraction_stop);
 
         hierarchy.push_back(finer, NULL); // append the last created level
@@ -37,10 +37,12 @@ public:
 
         void perform_coarsening(const PartitionConfig & config, graph_access & G, graph_hierarchy & hierarchy);
 
-private:
+        // the stop rule which perform_coarsening uses for config, sets the max vertex weight of config
         std::unique_ptr<stop_rule> get_stop_rule(graph_access& G, PartitionConfig& config) {
                 if (config.mode_node_separators) {
                         return std::make_unique<separator_simple_stop_rule>(config, G.number_of_nodes());
+                } else if (config.deep_multilevel) {
+                        return std::make_unique<deep_multilevel_stop_rule>(config, G.number_of_nodes());
                 } else {
                         if(config.stop_rule == STOP_RULE_SIMPLE) {
                                 return  std::make_unique<simple_stop_rule>(config, G.number_of_nodes());
@@ -317,7 +317,6 @@ void contraction::parallel_fast_contract_clustering(const PartitionConfig& parti
         parallel::submit_for_all(task2);
 
         coarser.start_construction(nodes, edges);
-        ALWAYS_ASSERT(!partition_config.graph_allready_partitioned);
 
         CLOCK_END("Calculate edges array");
 }
@@ -530,7 +529,6 @@ void contraction::parallel_fast_contract_clustering_multiple_threads_balls_and_b
         parallel::submit_for_all(task2);
 
         coarser.start_construction(nodes, edges);
-        ALWAYS_ASSERT(!partition_config.graph_allready_partitioned);
 
         CLOCK_END("Calculate edges array");
 
@@ -542,6 +540,27 @@ void contraction::parallel_fast_contract_clustering_multiple_threads_balls_and_b
         CLOCK_END("Clean hash tables");
 }
 
+void contraction::parallel_project_partition_to_coarser(const PartitionConfig& partition_config,
+                                                        graph_access& G,
+                                                        graph_access& coarser,
+                                                        const CoarseMapping& coarse_mapping,
+                                                        const NodeID& no_of_coarse_vertices) const {
+        CLOCK_START;
+        coarser.set_partition_count(G.get_partition_count());
+        if (partition_config.combine) {
+                coarser.resizeSecondPartitionIndex(no_of_coarse_vertices);
+        }
+
+        // all vertices of a cluster write the same block, so it does not matter which write wins
+        parallel::parallel_for_index(NodeID(0), G.number_of_nodes(), [&](NodeID node) {
+                coarser.setPartitionIndex(coarse_mapping[node], G.getPartitionIndex(node));
+                if (partition_config.combine) {
+                        coarser.setSecondPartitionIndex(coarse_mapping[node], G.getSecondPartitionIndex(node));
+                }
+        });
+        CLOCK_END("Project partition to coarser");
+}
+
 void contraction::parallel_contract_matching(const PartitionConfig& partition_config,
                                              graph_access& G,
                                              graph_access& coarser,
@@ -799,10 +818,27 @@ void contraction::contract_partitioned(const PartitionConfig& partition_config,
                                        const NodePermutationMap& permutation) const {
 
         if (partition_config.matching_type == CLUSTER_COARSENING) {
-                return contract_clustering(partition_config, G, coarser, edge_matching, coarse_mapping,
+                if (!partition_config.fast_contract_clustering) {
+                        return contract_clustering(partition_config, G, coarser, edge_matching, coarse_mapping,
+                                                   no_of_coarse_vertices, permutation);
+                }
+
+                // the clustering respects the partition, so the coarse graph is built exactly like for an
+                // unpartitioned graph and the blocks are copied afterwards
+                parallel_fast_contract_clustering(partition_config, G, coarser, edge_matching, coarse_mapping,
+                                                  no_of_coarse_vertices, permutation);
+                parallel_project_partition_to_coarser(partition_config, G, coarser, coarse_mapping,
+                                                      no_of_coarse_vertices);
+                return;
+        } else if (partition_config.matching_type == MATCHING_PARALLEL_LOCAL_MAX) {
+                parallel_contract_matching(partition_config, G, coarser, edge_matching, coarse_mapping,
                                            no_of_coarse_vertices, permutation);
-        }
 
+                // the matching respects the partition, so both vertices of a pair are in the same block
+                parallel_project_partition_to_coarser(partition_config, G, coarser, coarse_mapping,
+                                                      no_of_coarse_vertices);
+                return;
+        }
 
         std::vector<NodeID> new_edge_targets(G.number_of_edges());
         forall_edges(G, e){
@@ -131,6 +131,14 @@ private:
                 graph_access& coarser,
                 const CoarseMapping& coarse_mapping,
                 const NodeID& no_of_coarse_vertices) const;
+
+        // copies the blocks of the finer vertices to their coarse vertices,
+        // every coarse vertex has to consist of vertices of a single block
+        void parallel_project_partition_to_coarser(const PartitionConfig& partition_config,
+                                                   graph_access& G,
+                                                   graph_access& coarser,
+                                                   const CoarseMapping& coarse_mapping,
+                                                   const NodeID& no_of_coarse_vertices) const;
 };
 
 inline void contraction::visit_edge(graph_access& G,
@@ -372,7 +372,8 @@ void local_max_matching::parallel_match_with_queue_exp(const PartitionConfig& pa
                                         ALWAYS_ASSERT(edge_rating > 0.0);
 
                                         if ((edge_rating > max_rating || (edge_rating == max_rating && target < max_neighbor))
-                                            && vertex_mark[target] != MATCHED && coarser_weight <= partition_config.max_vertex_weight) {
+                                            && vertex_mark[target] != MATCHED && coarser_weight <= partition_config.max_vertex_weight
+                                            && respects_partition(partition_config, G, node, target)) {
                                                 max_neighbor = target;
                                                 max_rating = edge_rating;
                                         }
@@ -549,7 +550,8 @@ void local_max_matching::parallel_match_with_queue_exp_with_removal(const Partit
                                         ALWAYS_ASSERT(edge_rating > 0.0);
 
                                         if ((edge_rating > max_rating || (edge_rating == max_rating && target < max_neighbor))
-                                            && coarser_weight <= partition_config.max_vertex_weight) {
+                                            && coarser_weight <= partition_config.max_vertex_weight
+                                            && respects_partition(partition_config, G, node, target)) {
                                                 max_neighbor = target;
                                                 max_rating = edge_rating;
                                         }
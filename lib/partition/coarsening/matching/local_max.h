@@ -72,6 +72,15 @@ private:
         NodeID find_max_neighbour_parallel(NodeID node, graph_access& G, const PartitionConfig& partition_config,
                                            ParallelVector<AtomicWrapper<int>>& vertex_mark, random& rnd) const;
 
+        // vertices of different blocks are never matched if the graph is already partitioned
+        inline bool respects_partition(const PartitionConfig& partition_config, graph_access& G, NodeID node,
+                                       NodeID target) const {
+                return (!partition_config.graph_allready_partitioned
+                        || G.getPartitionIndex(node) == G.getPartitionIndex(target))
+                       && (!partition_config.combine
+                           || G.getSecondPartitionIndex(node) == G.getSecondPartitionIndex(target));
+        }
+
         enum MatchingPhases {
                 NOT_STARTED = 0,
                 STARTED = 1,
@@ -162,6 +162,26 @@ private:
         const PartitionConfig& m_config;
 };
 
+// coarsens until only a few blocks can be created, the blocks are split during uncoarsening
+// hence a coarse vertex must not be heavier than a block of the final partition
+class deep_multilevel_stop_rule : public stop_rule {
+public:
+        deep_multilevel_stop_rule(PartitionConfig& config, NodeID number_of_nodes)
+                :       num_stop(2 * config.deep_multilevel_nodes_per_block)
+        {
+                config.max_vertex_weight = config.upper_bound_partition;
+        };
+        virtual ~deep_multilevel_stop_rule() {};
+        bool stop(NodeID number_of_finer_vertices, graph_access& coarser) override {
+                NodeID no_of_coarser_vertices = coarser.number_of_nodes();
+                double contraction_rate = 1.0 * number_of_finer_vertices / (double)no_of_coarser_vertices;
+                return contraction_rate >= 1.1 && no_of_coarser_vertices >= num_stop;
+        }
+
+private:
+        NodeID num_stop;
+};
+
 class multiple_k_strong_contraction : public multiple_k_stop_rule {
 public:
         multiple_k_strong_contraction(PartitionConfig& _config, NodeID _number_of_nodes, EdgeID _number_of_edges)
@@ -27,13 +27,19 @@
 #include "quality_metrics.h"
 #include "tools/random_functions.h"
 #include "uncoarsening/uncoarsening.h"
+#include "uncoarsening/parallel_uncoarsening.h"
 #include "uncoarsening/refinement/mixed_refinement.h"
 #include "w_cycles/wcycle_partitioner.h"
 #include "uncoarsening/refinement/parallel_kway_graph_refinement/multitry_kway_fm.h"
 
+#include "data_structure/parallel/thread_context.h"
 #include "data_structure/parallel/time.h"
 
-graph_partitioner::graph_partitioner() {
+#include <algorithm>
+#include <future>
+
+graph_partitioner::graph_partitioner()
+        : m_cut_bound(nullptr), m_partial_cut(0), m_aborted(false) {
 
 }
 
@@ -46,6 +52,8 @@ void graph_partitioner::perform_recursive_partitioning(PartitionConfig & config,
         m_global_upper_bound = config.upper_bound_partition;
         m_rnd_bal = random_functions::nextDouble(1,2);
         m_global_work_load = config.work_load;
+        m_partial_cut      = 0;
+        m_aborted          = false;
 
         perform_recursive_partitioning_internal(config, G, 0, config.k-1, 1.0);
 }
@@ -55,6 +63,15 @@ void graph_partitioner::perform_recursive_partitioning_internal(PartitionConfig
                                                                 PartitionID lb, 
                                                                 PartitionID ub, double part_fraction) {
 
+        if(m_aborted) {
+                // the result is dominated anyway
+                forall_nodes(G, node) {
+                        G.setPartitionIndex(node, lb);
+                } endfor
+                G.set_partition_count(config.k);
+                return;
+        }
+
         G.set_partition_count(2);
         
         // %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -120,7 +137,17 @@ void graph_partitioner::perform_recursive_partitioning_internal(PartitionConfig
 
         perform_partitioning(bipart_config, G);
 
-        if( config.k > 2 ) {
+        if(m_cut_bound != nullptr) {
+                // the cut only grows during further bisections
+                quality_metrics qm;
+                EdgeWeight cut         = qm.edge_cut(G);
+                EdgeWeight partial_cut = m_partial_cut.fetch_add(cut, std::memory_order_relaxed) + cut;
+                if(partial_cut >= m_cut_bound->load(std::memory_order_relaxed)) {
+                        m_aborted = true;
+                }
+        }
+
+        if( config.k > 2 && !m_aborted ) {
                graph_extractor extractor;
  
                graph_access extracted_block_lhs;
@@ -137,41 +164,57 @@ void graph_partitioner::perform_recursive_partitioning_internal(PartitionConfig
                                                mapping_extracted_to_G_rhs, 
                                                weight_lhs_block, weight_rhs_block);
 
-               PartitionConfig rec_config = config;
-               if(num_blocks_lhs > 1) {
-                       rec_config.k = num_blocks_lhs;
-
-                       rec_config.largest_graph_weight = weight_lhs_block;
-                       rec_config.work_load            = weight_lhs_block;
-                       perform_recursive_partitioning_internal( rec_config, extracted_block_lhs, lb, new_ub_lhs, part_fraction * num_blocks_lhs/(num_blocks_lhs + num_blocks_rhs + 0.0));
-                       
-                       //apply partition
-                       forall_nodes(extracted_block_lhs, node) {
-                               G.setPartitionIndex(mapping_extracted_to_G_lhs[node], extracted_block_lhs.getPartitionIndex(node));
-                       } endfor
- 
-               } else {
-                       //apply partition
-                       forall_nodes(extracted_block_lhs, node) {
-                               G.setPartitionIndex(mapping_extracted_to_G_lhs[node], lb);
-                       } endfor
-               }
-
-               if(num_blocks_rhs > 1) {
-                       rec_config.k = num_blocks_rhs;
-                       rec_config.largest_graph_weight = weight_rhs_block;
-                       rec_config.work_load            = weight_rhs_block;
-                       perform_recursive_partitioning_internal( rec_config, extracted_block_rhs, new_lb_rhs, ub, part_fraction * num_blocks_rhs/(num_blocks_lhs + num_blocks_rhs + 0.0));
-
-                       forall_nodes(extracted_block_rhs, node) {
-                               G.setPartitionIndex(mapping_extracted_to_G_rhs[node], extracted_block_rhs.getPartitionIndex(node));
-                       } endfor
-
+               // partitions one extracted block and writes the result back into G. Both sides
+               // write disjoint sets of nodes, so they can run concurrently.
+               auto partition_block = [&](graph_access& extracted_block, std::vector<NodeID>& mapping,
+                                          NodeWeight block_weight, PartitionID block_lb, PartitionID block_ub,
+                                          NodeID num_blocks, uint32_t num_threads) {
+                       if(num_blocks > 1) {
+                               PartitionConfig rec_config = config;
+                               rec_config.k = num_blocks;
+
+                               rec_config.largest_graph_weight = block_weight;
+                               rec_config.work_load            = block_weight;
+                               rec_config.recursive_bipartitioning_threads = num_threads;
+                               perform_recursive_partitioning_internal( rec_config, extracted_block, block_lb, block_ub, part_fraction * num_blocks/(num_blocks_lhs + num_blocks_rhs + 0.0));
+
+                               //apply partition
+                               forall_nodes(extracted_block, node) {
+                                       G.setPartitionIndex(mapping[node], extracted_block.getPartitionIndex(node));
+                               } endfor
+                       } else {
+                               //apply partition
+                               forall_nodes(extracted_block, node) {
+                                       G.setPartitionIndex(mapping[node], block_lb);
+                               } endfor
+                       }
+               };
+
+               uint32_t num_threads = config.recursive_bipartitioning_threads;
+               if(num_threads > 1 && num_blocks_lhs > 1 && num_blocks_rhs > 1) {
+                       // split the threads between both subproblems proportionally to their sizes
+                       double size_lhs = extracted_block_lhs.number_of_nodes() + extracted_block_lhs.number_of_edges();
+                       double size_rhs = extracted_block_rhs.number_of_nodes() + extracted_block_rhs.number_of_edges();
+                       uint32_t num_threads_lhs = round(num_threads * size_lhs / std::max(size_lhs + size_rhs, 1.0));
+                       num_threads_lhs = std::min(std::max(num_threads_lhs, 1u), num_threads - 1);
+
+                       // random_functions is thread local, seed the new thread from this one
+                       int seed = random_functions::nextInt(0, std::numeric_limits<int>::max());
+                       parallel::thread_context context = parallel::t_thread_context;
+                       auto rhs_future = std::async(std::launch::async, [&, seed, context]() {
+                               parallel::scoped_thread_context scope(context);
+                               random_functions::setSeed(seed);
+                               partition_block(extracted_block_rhs, mapping_extracted_to_G_rhs, weight_rhs_block,
+                                               new_lb_rhs, ub, num_blocks_rhs, num_threads - num_threads_lhs);
+                       });
+                       partition_block(extracted_block_lhs, mapping_extracted_to_G_lhs, weight_lhs_block,
+                                       lb, new_ub_lhs, num_blocks_lhs, num_threads_lhs);
+                       rhs_future.get();
                } else {
-                       //apply partition
-                       forall_nodes(extracted_block_rhs, node) {
-                               G.setPartitionIndex(mapping_extracted_to_G_rhs[node], ub);
-                       } endfor
+                       partition_block(extracted_block_lhs, mapping_extracted_to_G_lhs, weight_lhs_block,
+                                       lb, new_ub_lhs, num_blocks_lhs, num_threads);
+                       partition_block(extracted_block_rhs, mapping_extracted_to_G_rhs, weight_rhs_block,
+                                       new_lb_rhs, ub, num_blocks_rhs, num_threads);
                }
 
         } else {
@@ -189,6 +232,17 @@ void graph_partitioner::perform_recursive_partitioning_internal(PartitionConfig
 
 void graph_partitioner::single_run( PartitionConfig & config, graph_access & G) {
 
+        if(config.deep_multilevel) {
+                bool power_of_two = config.k >= 2 && (config.k & (config.k - 1)) == 0;
+                // blocks are only split by the parallel uncoarsening
+                bool parallel_refinement = config.parallel_multitry_kway || config.parallel_lp;
+                if(!power_of_two || !parallel_refinement || config.use_wcycles || config.use_fullmultigrid
+                   || config.mode_node_separators || config.graph_allready_partitioned) {
+                        std::cout <<  "deep multilevel partitioning needs a power of two k, parallel refinement and plain v-cycles on an unpartitioned graph, falling back to the standard scheme"  << std::endl;
+                        config.deep_multilevel = false;
+                }
+        }
+
         for( unsigned i = 1; i <= config.global_cycle_iterations; i++) {
                 PRINT(std::cout <<  "vcycle " << i << " of " << config.global_cycle_iterations  << std::endl;)
                         if(config.use_wcycles || config.use_fullmultigrid)  {
@@ -218,7 +272,15 @@ void graph_partitioner::single_run( PartitionConfig & config, graph_access & G)
                                 CLOCK_END("Coarsening");
 
                                 CLOCK_START_N;
-                                init_part.perform_initial_partitioning(config, hierarchy);
+                                if(config.deep_multilevel) {
+                                        // only a few blocks fit on the coarsest graph, the others are split off during uncoarsening
+                                        PartitionConfig init_config = config;
+                                        init_config.k = parallel::uncoarsening::deep_multilevel_num_blocks(config, hierarchy.get_coarsest()->number_of_nodes());
+                                        init_config.upper_bound_partition = parallel::uncoarsening::deep_multilevel_upper_bound(config, init_config.k);
+                                        init_part.perform_initial_partitioning(init_config, hierarchy);
+                                } else {
+                                        init_part.perform_initial_partitioning(config, hierarchy);
+                                }
                                 CLOCK_END("Initial partitioning");
 
                                 CLOCK_START_N;
@@ -227,10 +289,89 @@ void graph_partitioner::single_run( PartitionConfig & config, graph_access & G)
                                 if( config.mode_node_separators ) {
                                         quality_metrics qm;
                                         std::cerr <<  "vcycle result " << qm.separator_weight(G)  << std::endl;
+                                } else if( config.global_cycle_iterations > 1 ) {
+                                        quality_metrics qm;
+                                        std::cout <<  "vcycle " << i << " cut\t" << qm.edge_cut(G)  << std::endl;
                                 }
                         }
                 config.graph_allready_partitioned = true;
                 config.balance_factor             = 0;
+                // further v-cycles keep all k blocks
+                config.deep_multilevel            = false;
+        }
+}
+
+void graph_partitioner::perform_batch_partitioning( PartitionConfig & config, graph_access & G,
+                                                    const std::vector<PartitionID> & ks,
+                                                    std::vector< std::vector<PartitionID> > & partitions) {
+        ALWAYS_ASSERT(!ks.empty());
+        if(config.use_wcycles || config.use_fullmultigrid || config.mode_node_separators || config.deep_multilevel
+           || config.global_cycle_iterations > 1) {
+                std::cout <<  "batch partitioning uses a single v-cycle per k"  << std::endl;
+        }
+
+        // block weight bound for k blocks, computed as in balance_configuration
+        auto upper_bound = [&config](PartitionID k) {
+                double epsilon = config.imbalance/100.0;
+                if(config.imbalance == 0 && !config.kaffpaE) {
+                        return (NodeWeight)((1+epsilon+0.01)*ceil(config.largest_graph_weight/(double)k));
+                }
+                return (NodeWeight)((1+epsilon)*ceil(config.work_load/(double)k));
+        };
+
+        // the largest k has the smallest cluster weights, so its hierarchy is valid for all other k.
+        // each k starts initial partitioning at the level where its own stop rule ends coarsening
+        PartitionConfig coarsening_config            = config;
+        coarsening_config.k                          = *std::max_element(ks.begin(), ks.end());
+        coarsening_config.upper_bound_partition      = upper_bound(coarsening_config.k);
+        coarsening_config.graph_allready_partitioned = false;
+
+        graph_hierarchy hierarchy;
+        hierarchy.set_persistent(true);
+
+        CLOCK_START;
+        coarsening coarsen;
+        coarsen.perform_coarsening(coarsening_config, G, hierarchy);
+        CLOCK_END("Coarsening");
+
+        partitions.resize(ks.size());
+        for( unsigned i = 0; i < ks.size(); i++) {
+                PartitionConfig k_config             = config;
+                k_config.k                           = ks[i];
+                k_config.upper_bound_partition       = upper_bound(ks[i]);
+                k_config.graph_allready_partitioned  = false;
+                k_config.deep_multilevel             = false;
+
+                // replays the stop decisions of coarsening with k_config on the levels of the hierarchy
+                PartitionConfig stop_config = k_config;
+                std::unique_ptr<stop_rule> k_stop_rule = coarsen.get_stop_rule(G, stop_config);
+                unsigned int coarsest_level = 1;
+                while(coarsest_level + 1 < hierarchy.number_of_levels()
+                      && k_stop_rule->stop(hierarchy.get_level(coarsest_level - 1)->number_of_nodes(),
+                                           *hierarchy.get_level(coarsest_level))) {
+                        coarsest_level++;
+                }
+                hierarchy.rewind(coarsest_level);
+                std::cout <<  "k " << ks[i] << " starts at level " << coarsest_level << " with "
+                          << hierarchy.get_coarsest()->number_of_nodes() << " nodes" << std::endl;
+
+                CLOCK_START_N;
+                initial_partitioning init_part;
+                init_part.perform_initial_partitioning(k_config, hierarchy);
+                CLOCK_END("Initial partitioning");
+
+                CLOCK_START_N;
+                uncoarsening uncoarsen;
+                uncoarsen.perform_uncoarsening(k_config, hierarchy);
+                CLOCK_END("Uncoarsening");
+
+                partitions[i].resize(G.number_of_nodes());
+                forall_nodes(G, node) {
+                        partitions[i][node] = G.getPartitionIndex(node);
+                } endfor
+
+                quality_metrics qm;
+                std::cout <<  "k " << ks[i] << " cut\t" << qm.edge_cut(G)  << std::endl;
         }
 }
 
@@ -23,6 +23,8 @@
 #ifndef PARTITION_OL9XTLU4
 #define PARTITION_OL9XTLU4
 
+#include <atomic>
+
 #include "coarsening/coarsening.h"
 #include "coarsening/stop_rules/stop_rules.h"
 #include "data_structure/graph_access.h"
@@ -37,6 +39,22 @@ public:
         void perform_partitioning(PartitionConfig & graph_partitioner_config, graph_access & G);
         void perform_recursive_partitioning(PartitionConfig & graph_partitioner_config, graph_access & G);
 
+        // partitions G for every block count in ks with a single coarsening hierarchy, which is built
+        // for the largest k and replayed for every k. partitions[i] is the partition for ks[i].
+        void perform_batch_partitioning(PartitionConfig & graph_partitioner_config, graph_access & G,
+                                        const std::vector<PartitionID> & ks,
+                                        std::vector< std::vector<PartitionID> > & partitions);
+
+        // recursive partitioning stops splitting as soon as the cut of the bisections done so far
+        // reaches the bound. The partition is incomplete in that case, see aborted().
+        void set_cut_bound(const std::atomic<EdgeWeight>* cut_bound) {
+                m_cut_bound = cut_bound;
+        }
+
+        bool aborted() const {
+                return m_aborted.load(std::memory_order_relaxed);
+        }
+
 private:
         void perform_recursive_partitioning_internal(PartitionConfig & graph_partitioner_config, 
                                                      graph_access & G, 
@@ -47,6 +65,10 @@ private:
 	int m_global_upper_bound;
         int m_rnd_bal;
         NodeWeight m_global_work_load;
+
+        const std::atomic<EdgeWeight>* m_cut_bound;
+        std::atomic<EdgeWeight> m_partial_cut;
+        std::atomic<bool> m_aborted;
 };
 
 #endif /* end of include guard: PARTITION_OL9XTLU4 */
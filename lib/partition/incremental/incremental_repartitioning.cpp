@@ -0,0 +1,225 @@
+#include "data_structure/parallel/algorithm.h"
+#include "data_structure/parallel/time.h"
+#include "partition/incremental/incremental_repartitioning.h"
+#include "partition/uncoarsening/refinement/parallel_kway_graph_refinement/multitry_kway_fm.h"
+
+#include <algorithm>
+#include <iostream>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace parallel {
+
+int incremental_repartitioning::apply_delta(const graph_delta& delta, graph_access& old_G, graph_access& new_G,
+                                            std::vector<NodeID>& touched) {
+        CLOCK_START;
+        const NodeID old_num_nodes = old_G.number_of_nodes();
+        const NodeID num_nodes = old_num_nodes + delta.new_node_weights.size();
+
+        auto edge_key = [](NodeID u, NodeID v) {
+                return (uint64_t(std::min(u, v)) << 32) | std::max(u, v);
+        };
+
+        std::unordered_set<uint64_t> removed_edges;
+        removed_edges.reserve(delta.removed_edges.size());
+        for (const auto& edge : delta.removed_edges) {
+                bool exists = false;
+                if (edge.source < old_num_nodes && edge.target < old_num_nodes) {
+                        forall_out_edges(old_G, e, edge.source) {
+                                if (old_G.getEdgeTarget(e) == edge.target) {
+                                        exists = true;
+                                        break;
+                                }
+                        } endfor
+                }
+                if (!exists) {
+                        std::cerr << "Removed edge (" << edge.source + 1 << ", " << edge.target + 1
+                                  << ") does not exist in the graph" << std::endl;
+                        return 1;
+                }
+                removed_edges.insert(edge_key(edge.source, edge.target));
+        }
+
+        std::unordered_map<NodeID, std::vector<std::pair<NodeID, EdgeWeight>>> added_edges;
+        for (const auto& edge : delta.added_edges) {
+                if (edge.source >= num_nodes || edge.target >= num_nodes) {
+                        std::cerr << "Added edge (" << edge.source + 1 << ", " << edge.target + 1
+                                  << ") has an endpoint which is not in the graph" << std::endl;
+                        return 1;
+                }
+                added_edges[edge.source].emplace_back(edge.target, edge.weight);
+                added_edges[edge.target].emplace_back(edge.source, edge.weight);
+        }
+
+        std::vector<NodeWeight> node_weights(num_nodes);
+        forall_nodes(old_G, node) {
+                node_weights[node] = old_G.getNodeWeight(node);
+        } endfor
+        std::copy(delta.new_node_weights.begin(), delta.new_node_weights.end(),
+                  node_weights.begin() + old_num_nodes);
+        for (const auto& node_weight : delta.node_weights) {
+                if (node_weight.first >= num_nodes) {
+                        std::cerr << "Node " << node_weight.first + 1 << " is not in the graph" << std::endl;
+                        return 1;
+                }
+                node_weights[node_weight.first] = node_weight.second;
+        }
+
+        std::vector<bool> is_touched(num_nodes, false);
+        auto touch = [&](NodeID node) {
+                if (!is_touched[node]) {
+                        is_touched[node] = true;
+                        touched.push_back(node);
+                }
+        };
+        for (const auto& edge : delta.removed_edges) {
+                touch(edge.source);
+                touch(edge.target);
+        }
+        for (const auto& edge : delta.added_edges) {
+                touch(edge.source);
+                touch(edge.target);
+        }
+        for (const auto& node_weight : delta.node_weights) {
+                touch(node_weight.first);
+        }
+        for (NodeID node = old_num_nodes; node < num_nodes; ++node) {
+                touch(node);
+        }
+
+        PartitionID k = old_G.get_partition_count();
+        std::vector<PartitionID> partition(num_nodes);
+        std::vector<NodeWeight> block_weights(k, 0);
+        forall_nodes(old_G, node) {
+                partition[node] = old_G.getPartitionIndex(node);
+                block_weights[partition[node]] += node_weights[node];
+        } endfor
+
+        EdgeID num_edges = old_G.number_of_edges() + 2 * delta.added_edges.size();
+        new_G.start_construction(num_nodes, num_edges);
+
+        std::vector<std::pair<NodeID, EdgeWeight>> edges;
+        std::vector<EdgeWeight> connection(k, 0);
+        for (NodeID node = 0; node < num_nodes; ++node) {
+                edges.clear();
+                if (node < old_num_nodes) {
+                        forall_out_edges(old_G, e, node) {
+                                NodeID target = old_G.getEdgeTarget(e);
+                                if (removed_edges.empty() || removed_edges.count(edge_key(node, target)) == 0) {
+                                        edges.emplace_back(target, old_G.getEdgeWeight(e));
+                                }
+                        } endfor
+                }
+
+                auto it = added_edges.find(node);
+                if (it != added_edges.end()) {
+                        // an added edge which already exists increases the weight of the existing edge
+                        edges.insert(edges.end(), it->second.begin(), it->second.end());
+                        std::sort(edges.begin(), edges.end());
+                        size_t last = 0;
+                        for (size_t i = 1; i < edges.size(); ++i) {
+                                if (edges[i].first == edges[last].first) {
+                                        edges[last].second += edges[i].second;
+                                } else {
+                                        edges[++last] = edges[i];
+                                }
+                        }
+                        edges.resize(last + 1);
+                }
+
+                if (node >= old_num_nodes) {
+                        // new nodes join the block they are connected to most strongly, nodes without
+                        // assigned neighbors join the lightest block
+                        PartitionID best_block = std::min_element(block_weights.begin(), block_weights.end())
+                                                 - block_weights.begin();
+                        EdgeWeight best_connection = 0;
+                        for (const auto& edge : edges) {
+                                if (edge.first < node) {
+                                        PartitionID block = partition[edge.first];
+                                        connection[block] += edge.second;
+                                        if (connection[block] > best_connection) {
+                                                best_connection = connection[block];
+                                                best_block = block;
+                                        }
+                                }
+                        }
+                        for (const auto& edge : edges) {
+                                if (edge.first < node) {
+                                        connection[partition[edge.first]] = 0;
+                                }
+                        }
+                        partition[node] = best_block;
+                        block_weights[best_block] += node_weights[node];
+                }
+
+                NodeID new_node = new_G.new_node();
+                new_G.setNodeWeight(new_node, node_weights[node]);
+                new_G.setPartitionIndex(new_node, partition[node]);
+                for (const auto& edge : edges) {
+                        EdgeID e = new_G.new_edge(new_node, edge.first);
+                        new_G.setEdgeWeight(e, edge.second);
+                }
+        }
+        new_G.finish_construction();
+        new_G.set_partition_count(k);
+
+        std::cout << "touched nodes\t" << touched.size() << std::endl;
+        CLOCK_END("Apply graph delta");
+        return 0;
+}
+
+EdgeWeight incremental_repartitioning::perform_refinement(PartitionConfig& config, graph_access& G,
+                                                          const std::vector<NodeID>& touched) {
+        atomic_bitmap region(G.number_of_nodes());
+        mark_region(config, G, touched, region);
+
+        CLOCK_START;
+        boundary_type boundary(G, config);
+        boundary.construct_boundary(region);
+        CLOCK_END(">> Build boundary");
+
+        CLOCK_START_N;
+        multitry_kway_fm multitry_kway(config, G, boundary);
+        EdgeWeight improvement = multitry_kway.perform_refinement(config, G, boundary, config.global_multitry_rounds,
+                                                                  true, config.kway_adaptive_limits_alpha);
+        CLOCK_END(">> Refinement");
+        return improvement;
+}
+
+void incremental_repartitioning::mark_region(const PartitionConfig& config, graph_access& G,
+                                             const std::vector<NodeID>& touched, atomic_bitmap& region) {
+        CLOCK_START;
+        std::vector<NodeID> frontier;
+        frontier.reserve(touched.size());
+        for (NodeID node : touched) {
+                if (region.test_and_set(node)) {
+                        frontier.push_back(node);
+                }
+        }
+
+        size_t region_size = frontier.size();
+        std::vector<std::vector<NodeID>> next_frontiers(current_thread_pool().NumThreads() + 1);
+        for (uint32_t hop = 0; hop < config.incremental_hops && !frontier.empty(); ++hop) {
+                parallel::parallel_for_index(size_t(0), frontier.size(), [&](size_t index, uint32_t thread_id) {
+                        NodeID node = frontier[index];
+                        forall_out_edges(G, e, node) {
+                                NodeID target = G.getEdgeTarget(e);
+                                if (region.test_and_set(target)) {
+                                        next_frontiers[thread_id].push_back(target);
+                                }
+                        } endfor
+                });
+
+                frontier.clear();
+                for (auto& next_frontier : next_frontiers) {
+                        frontier.insert(frontier.end(), next_frontier.begin(), next_frontier.end());
+                        next_frontier.clear();
+                }
+                region_size += frontier.size();
+        }
+
+        std::cout << "refinement region\t" << region_size << std::endl;
+        CLOCK_END("Mark refinement region");
+}
+
+}
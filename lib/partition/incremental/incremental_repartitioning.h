@@ -0,0 +1,31 @@
+#pragma once
+
+#include <vector>
+
+#include "data_structure/graph_access.h"
+#include "data_structure/graph_delta.h"
+#include "data_structure/parallel/atomic_bitmap.h"
+#include "partition/partition_config.h"
+
+namespace parallel {
+
+// Repartitioning of a slowly changing graph. The partition of the old graph is carried over to the
+// changed graph and only the neighborhood of the changes is refined, hence few nodes migrate and the
+// running time depends on the size of the changes rather than on the size of the graph.
+class incremental_repartitioning {
+public:
+        // builds new_G from the partitioned old_G and the delta, new nodes are assigned to the block
+        // they are connected to most strongly. All nodes incident to a change are stored in touched.
+        int apply_delta(const graph_delta& delta, graph_access& old_G, graph_access& new_G,
+                        std::vector<NodeID>& touched);
+
+        // refines the partition of G around the touched nodes and returns the improvement of the cut
+        EdgeWeight perform_refinement(PartitionConfig& config, graph_access& G, const std::vector<NodeID>& touched);
+
+private:
+        // marks all nodes within config.incremental_hops hops of the touched nodes
+        void mark_region(const PartitionConfig& config, graph_access& G, const std::vector<NodeID>& touched,
+                         atomic_bitmap& region);
+};
+
+}
@@ -20,6 +20,10 @@
  * this program.  If not, see <http://www.gnu.org/licenses/>.
  *****************************************************************************/
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
 #include "bipartition.h"
 #include "data_structure/priority_queues/maxNodeHeap.h"
 #include "quality_metrics.h"
@@ -52,6 +56,10 @@ void bipartition::initial_partition( const PartitionConfig & config,
                         grow_regions_bfs(config, G);
                 } else if( config.bipartition_algorithm == BIPARTITION_FM) {
                         grow_regions_fm(config, G);
+                } else if( config.bipartition_algorithm == BIPARTITION_RANDOM) {
+                        grow_regions_random(config, G);
+                } else if( config.bipartition_algorithm == BIPARTITION_SPECTRAL) {
+                        grow_regions_spectral(config, G);
                 } 
 
                 G.set_partition_count(2);
@@ -310,3 +318,91 @@ void bipartition::grow_regions_fm(const PartitionConfig & config, graph_access &
         }
         delete queue;
 }
+
+void bipartition::grow_regions_random(const PartitionConfig & config, graph_access & G) {
+        if(G.number_of_nodes() == 0) return;
+
+        std::vector<NodeID> permutation(G.number_of_nodes());
+        random_functions::permutate_vector_good(permutation, true);
+
+        forall_nodes(G, node) {
+                G.setPartitionIndex(node, 1);
+        } endfor
+
+        // post_fm repairs the cut of the random partition
+        NodeWeight cur_partition_weight = 0;
+        for( NodeID node : permutation) {
+                if(cur_partition_weight >= (NodeWeight) config.grow_target) break;
+
+                G.setPartitionIndex(node, 0);
+                cur_partition_weight += G.getNodeWeight(node);
+        }
+}
+
+void bipartition::grow_regions_spectral(const PartitionConfig & config, graph_access & G) {
+        if(G.number_of_nodes() == 0) return;
+
+        const unsigned power_iterations = 30;
+        NodeID n = G.number_of_nodes();
+
+        std::vector<double> degree(n);
+        double max_degree = 0;
+        forall_nodes(G, node) {
+                degree[node] = G.getWeightedNodeDegree(node);
+                max_degree   = std::max(max_degree, degree[node]);
+        } endfor
+
+        // approximate the fiedler vector by power iteration with (shift * I - L). The eigenvector
+        // of L to eigenvalue 0 is constant and projected out in every step.
+        double shift = 2 * max_degree + 1;
+        std::vector<double> x(n);
+        std::vector<double> y(n);
+        forall_nodes(G, node) {
+                x[node] = random_functions::nextDouble(-1, 1);
+        } endfor
+
+        for( unsigned i = 0; i < power_iterations; i++) {
+                double sum = 0;
+                forall_nodes(G, node) {
+                        double value = (shift - degree[node]) * x[node];
+                        forall_out_edges(G, e, node) {
+                                value += G.getEdgeWeight(e) * x[G.getEdgeTarget(e)];
+                        } endfor
+                        y[node] = value;
+                        sum    += value;
+                } endfor
+
+                double mean = sum / n;
+                double norm = 0;
+                forall_nodes(G, node) {
+                        y[node] -= mean;
+                        norm    += y[node] * y[node];
+                } endfor
+
+                norm = sqrt(norm);
+                if(norm == 0) break;
+
+                forall_nodes(G, node) {
+                        x[node] = y[node] / norm;
+                } endfor
+        }
+
+        // nodes with the smallest values form block 0
+        std::vector<NodeID> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](NodeID lhs, NodeID rhs) {
+                return x[lhs] < x[rhs];
+        });
+
+        forall_nodes(G, node) {
+                G.setPartitionIndex(node, 1);
+        } endfor
+
+        NodeWeight cur_partition_weight = 0;
+        for( NodeID node : order) {
+                if(cur_partition_weight >= (NodeWeight) config.grow_target) break;
+
+                G.setPartitionIndex(node, 0);
+                cur_partition_weight += G.getNodeWeight(node);
+        }
+}
@@ -47,6 +47,8 @@ class bipartition : public initial_partitioner {
         private:
                 void grow_regions_bfs(const PartitionConfig & config, graph_access & G);
                 void grow_regions_fm(const PartitionConfig & config, graph_access & G);
+                void grow_regions_random(const PartitionConfig & config, graph_access & G);
+                void grow_regions_spectral(const PartitionConfig & config, graph_access & G);
                 NodeID find_start_node( const PartitionConfig & config, graph_access & G);
                 void post_fm(const PartitionConfig & config, graph_access & G);
                 inline Gain compute_gain( graph_access & G, NodeID node, PartitionID targeting_partition);
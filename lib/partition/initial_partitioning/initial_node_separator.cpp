@@ -3,6 +3,8 @@
 // 
 
 #include <fstream>
+#include <memory>
+#include "data_structure/parallel/silent_output.h"
 #include "initial_node_separator.h"
 #include "graph_partitioner.h"
 #include "tools/quality_metrics.h"
@@ -21,10 +23,7 @@ initial_node_separator::~initial_node_separator() {
 
 NodeWeight initial_node_separator::single_run( const PartitionConfig & config, graph_access & G) {
 
-        std::streambuf* backup = std::cout.rdbuf();
-        std::ofstream ofs;
-        ofs.open("/dev/null");
-        std::cout.rdbuf(ofs.rdbuf()); 
+        std::unique_ptr<parallel::silent_output> silence = std::make_unique<parallel::silent_output>();
 
         graph_partitioner partitioner;
         PartitionConfig partition_config         = config;
@@ -38,8 +37,7 @@ NodeWeight initial_node_separator::single_run( const PartitionConfig & config, g
         complete_boundary boundary(&G);
         boundary.build();
 
-        ofs.close();
-        std::cout.rdbuf(backup);
+        silence.reset();
 
         vertex_separator_algorithm vsa; std::vector<NodeID> separator;
         //create a very simple separator from that partition
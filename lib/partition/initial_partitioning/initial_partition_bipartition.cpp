@@ -21,12 +21,15 @@
  *****************************************************************************/
 
 #include <fstream>
+#include <memory>
+#include "data_structure/parallel/silent_output.h"
 #include "initial_partition_bipartition.h"
 #include "uncoarsening/refinement/kway_graph_refinement/kway_graph_refinement.h"
 #include "uncoarsening/refinement/mixed_refinement.h"
 #include "graph_partitioner.h"
 
-initial_partition_bipartition::initial_partition_bipartition() {
+initial_partition_bipartition::initial_partition_bipartition()
+        : m_cut_bound(nullptr), m_aborted(false) {
 
 }
 
@@ -58,11 +61,15 @@ void initial_partition_bipartition::initial_partition( const PartitionConfig & c
         }
 
         // turn off parallel mode
+        // parallel initial partitioning already keeps every thread busy with own repetitions,
+        // otherwise the recursion itself uses the threads
+        rec_config.recursive_bipartitioning_threads = config.parallel_initial_partitioning ? 1 : config.num_threads;
         rec_config.parallel_multitry_kway = false;
         rec_config.parallel_initial_partitioning = false;
         rec_config.parallel_lp = false;
         rec_config.parallel_coarsening_lp = false;
         rec_config.lp_before_local_search = false;
+        rec_config.deep_multilevel = false;
         rec_config.fast_contract_clustering = false;
         //rec_config.accept_small_coarser_graphs = true;
 
@@ -78,20 +85,16 @@ void initial_partition_bipartition::initial_partition( const PartitionConfig & c
                 rec_config.stop_rule = STOP_RULE_MULTIPLE_K;
         }
 
-        std::streambuf* backup;
-        std::ofstream ofs;
+        std::unique_ptr<parallel::silent_output> silence;
         if (!config.parallel_initial_partitioning) {
-                backup = std::cout.rdbuf();
-                ofs.open("/dev/null");
-                std::cout.rdbuf(ofs.rdbuf());
+                silence = std::make_unique<parallel::silent_output>();
         }
 
+        gp.set_cut_bound(m_cut_bound);
         gp.perform_recursive_partitioning(rec_config, G);
+        m_aborted = gp.aborted();
 
-        if (!config.parallel_initial_partitioning) {
-                ofs.close();
-                std::cout.rdbuf(backup);
-        }
+        silence.reset();
 
         forall_nodes(G, n) {
                 partition_map[n] =  G.getPartitionIndex(n);
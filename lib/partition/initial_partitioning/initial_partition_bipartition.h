@@ -23,6 +23,8 @@
 #ifndef INITIAL_PARTITION_BIPARTITION_HMA7329W
 #define INITIAL_PARTITION_BIPARTITION_HMA7329W
 
+#include <atomic>
+
 #include "initial_partitioner.h"
 
 class initial_partition_bipartition : public initial_partitioner {
@@ -40,6 +42,19 @@ public:
                                 int* adjwgt,
                                 int* partition_map); 
 
+        // repetitions whose partial cut reaches the bound are stopped early
+        void set_cut_bound(const std::atomic<EdgeWeight>* cut_bound) {
+                m_cut_bound = cut_bound;
+        }
+
+        // true if the last repetition was stopped early and its partition is incomplete
+        bool aborted() const {
+                return m_aborted;
+        }
+
+private:
+        const std::atomic<EdgeWeight>* m_cut_bound;
+        bool m_aborted;
 };
 
 
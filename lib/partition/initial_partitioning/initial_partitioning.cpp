@@ -27,6 +27,7 @@
 #include "graph_partitioner.h"
 #include "initial_partition_bipartition.h"
 #include "initial_partitioning.h"
+#include "initial_partitioning/parallel/initial_node_separator.h"
 #include "initial_partitioning/parallel/initial_partitioning.h"
 #include "initial_refinement/initial_refinement.h"
 #include "initial_node_separator.h"
@@ -150,7 +151,12 @@ void initial_partitioning::perform_initial_partitioning(const PartitionConfig &
 }
 
 void initial_partitioning::perform_initial_partitioning_separator(const PartitionConfig & config, graph_access &  G) {
-        initial_node_separator ipns;
-        ipns.compute_node_separator(config,G);
+        if(config.parallel_node_separator) {
+                parallel::initial_node_separator ipns;
+                ipns.compute_node_separator(config,G);
+        } else {
+                initial_node_separator ipns;
+                ipns.compute_node_separator(config,G);
+        }
 }
 
@@ -0,0 +1,131 @@
+#include "data_structure/parallel/silent_output.h"
+#include "data_structure/parallel/thread_pool.h"
+#include "data_structure/parallel/time.h"
+#include "graph_partitioner.h"
+#include "initial_partitioning/parallel/initial_node_separator.h"
+#include "partition/uncoarsening/separator/vertex_separator_algorithm.h"
+#include "quality_metrics.h"
+#include "random_functions.h"
+#include "tools/macros_assertions.h"
+
+#include <atomic>
+#include <memory>
+
+namespace parallel {
+
+NodeWeight initial_node_separator::single_run(const PartitionConfig& config, graph_access& G) {
+        graph_partitioner partitioner;
+        PartitionConfig partition_config         = config;
+        partition_config.mode_node_separators    = false;
+        partition_config.global_cycle_iterations = 1;
+        partition_config.repetitions             = 1;
+
+        // every thread runs its own repetitions, so the partitioner must not use the thread pool
+        partition_config.parallel_multitry_kway        = false;
+        partition_config.parallel_initial_partitioning = false;
+        partition_config.parallel_lp                   = false;
+        partition_config.parallel_coarsening_lp        = false;
+        partition_config.lp_before_local_search        = false;
+        partition_config.deep_multilevel               = false;
+        partition_config.fast_contract_clustering      = false;
+        partition_config.parallel_node_separator       = false;
+
+        partitioner.perform_partitioning(partition_config, G);
+
+        complete_boundary boundary(&G);
+        boundary.build();
+
+        vertex_separator_algorithm vsa;
+        std::vector<NodeID> separator;
+        if (partition_config.sep_full_boundary_ip) {
+                vsa.compute_vertex_separator_simpler(partition_config, G, boundary, separator);
+        } else {
+                vsa.compute_vertex_separator_simple(partition_config, G, boundary, separator);
+        }
+
+        std::vector<NodeID> output_separator;
+        vsa.improve_vertex_separator(partition_config, G, separator, output_separator);
+
+        quality_metrics qm;
+        return qm.separator_weight(G);
+}
+
+void initial_node_separator::compute_node_separator(const PartitionConfig& config, graph_access& G) {
+        if (config.graph_allready_partitioned) {
+                return;
+        }
+
+        const uint32_t tries_to_do = std::max<uint32_t>(std::max(config.max_initial_ns_tries, 1), config.num_threads);
+        std::atomic<uint32_t> tries_done(0);
+
+        auto task = [&](uint32_t id) -> std::pair<NodeWeight, std::unique_ptr<PartitionID[]>> {
+                if (id > 0) {
+                        random_functions::setSeed(id + config.seed);
+                }
+
+                // the threads share the nodes and edges of G and only own the separator
+                graph_access my_graph;
+                G.share_topology(my_graph);
+
+                NodeWeight best_separator_size = std::numeric_limits<NodeWeight>::max();
+                auto best_separator = std::make_unique<PartitionID[]>(G.number_of_nodes());
+                uint32_t unsucc_counter = 0;
+                while (tries_done.fetch_add(1, std::memory_order_relaxed) < tries_to_do) {
+                        if (best_separator_size != std::numeric_limits<NodeWeight>::max()
+                            && deadline_reached(config.deadline)) {
+                                break;
+                        }
+
+                        NodeWeight cur_separator_size = single_run(config, my_graph);
+                        if (cur_separator_size < best_separator_size) {
+                                forall_nodes(my_graph, node) {
+                                        best_separator[node] = my_graph.getPartitionIndex(node);
+                                } endfor
+                                best_separator_size = cur_separator_size;
+                                unsucc_counter = 0;
+                        } else {
+                                ++unsucc_counter;
+                        }
+
+                        if (config.faster_ns && unsucc_counter >= 5) {
+                                break;
+                        }
+                }
+                return std::make_pair(best_separator_size, std::move(best_separator));
+        };
+
+        std::vector<std::future<std::pair<NodeWeight, std::unique_ptr<PartitionID[]>>>> futures;
+        futures.reserve(current_thread_pool().NumThreads());
+
+        // the sequential partitioner writes a lot of output
+        auto silence = std::make_unique<silent_output>();
+
+        for (uint32_t id = 0; id < current_thread_pool().NumThreads(); ++id) {
+                futures.push_back(current_thread_pool().Submit(id, task, id + 1));
+        }
+
+        std::vector<std::pair<NodeWeight, std::unique_ptr<PartitionID[]>>> separators;
+        separators.push_back(task(0));
+        std::for_each(futures.begin(), futures.end(), [&](auto& future) {
+                separators.push_back(future.get());
+        });
+        silence.reset();
+
+        NodeWeight best_separator_size = std::numeric_limits<NodeWeight>::max();
+        PartitionID* best_separator = nullptr;
+        for (auto& separator : separators) {
+                if (separator.first < best_separator_size) {
+                        best_separator_size = separator.first;
+                        best_separator = separator.second.get();
+                }
+        }
+
+        ALWAYS_ASSERT(best_separator != nullptr);
+        G.set_partition_count(config.k);
+        forall_nodes(G, node) {
+                G.setPartitionIndex(node, best_separator[node]);
+        } endfor
+        std::cout << "initial separator size\t" << best_separator_size << std::endl;
+}
+
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "data_structure/graph_access.h"
+#include "partition_config.h"
+
+namespace parallel {
+
+class initial_node_separator {
+public:
+        // all threads compute initial separators with the sequential algorithm, the lightest one is kept
+        void compute_node_separator(const PartitionConfig& config, graph_access& G);
+
+private:
+        NodeWeight single_run(const PartitionConfig& config, graph_access& G);
+};
+
+}
@@ -1,4 +1,5 @@
 #include "data_structure/parallel/random.h"
+#include "data_structure/parallel/silent_output.h"
 #include "data_structure/parallel/thread_pool.h"
 #include "data_structure/parallel/time.h"
 #include "graph_partition_assertions.h"
@@ -9,7 +10,7 @@
 #include "tools/macros_assertions.h"
 #include "timer.h"
 
-#include <fstream>
+#include <memory>
 
 namespace parallel {
 
@@ -32,13 +33,34 @@ void initial_partitioning::perform_initial_partitioning(const PartitionConfig& c
 
         std::atomic<uint32_t> reps_done(0);
 
-        auto task_impl = [&qm, &config, &reps_done, &reps_to_do] (graph_access& G, uint32_t id)
-                -> std::pair<EdgeWeight, std::unique_ptr<int[]>>{
+        // portfolio mode: repetitions cycle through the bisection algorithms and share the best cut,
+        // repetitions which can not beat it anymore are stopped early
+        const std::vector<BipartitionAlgorithm> portfolio = {BIPARTITION_BFS, BIPARTITION_FM,
+                                                             BIPARTITION_RANDOM, BIPARTITION_SPECTRAL};
+        std::atomic<EdgeWeight> global_best_cut(std::numeric_limits<EdgeWeight>::max());
+        std::atomic<uint32_t> reps_cut_off(0);
+
+        // in later v-cycles the partition of the previous cycle competes with the new initial partitions
+        EdgeWeight given_cut = std::numeric_limits<EdgeWeight>::max();
+        std::unique_ptr<int[]> given_map;
+        if (config.graph_allready_partitioned && !config.omit_given_partitioning) {
+                given_cut = qm.edge_cut(G);
+                given_map = std::make_unique<int[]>(G.number_of_nodes());
+                forall_nodes(G, n) {
+                        given_map[n] = G.getPartitionIndex(n);
+                } endfor
+                global_best_cut.store(given_cut, std::memory_order_relaxed);
+        }
+
+        auto task_impl = [&qm, &config, &reps_done, &reps_to_do, &portfolio, &global_best_cut, &reps_cut_off, &t]
+                (graph_access& G, uint32_t id) -> std::pair<EdgeWeight, std::unique_ptr<int[]>>{
                 initial_partition_bipartition partition;
+                if (config.initial_partitioning_portfolio) {
+                        partition.set_cut_bound(&global_best_cut);
+                }
 
                 EdgeWeight best_cut = std::numeric_limits<EdgeWeight>::max();
                 std::unique_ptr<int[]> best_map = std::make_unique<int[]>(G.number_of_nodes());
-                ALWAYS_ASSERT(!(config.graph_allready_partitioned && !config.omit_given_partitioning));
 
                 std::unique_ptr<int[]> partition_map = std::make_unique<int[]>(G.number_of_nodes());
 
@@ -46,18 +68,43 @@ void initial_partitioning::perform_initial_partitioning(const PartitionConfig& c
                 if (!((config.graph_allready_partitioned && config.no_new_initial_partitioning) ||
                       config.omit_given_partitioning)) {
                         uint32_t rep = 0;
-                        while ((rep = reps_done.fetch_add(1, std::memory_order_release) < reps_to_do)) {
+                        while ((rep = reps_done.fetch_add(1, std::memory_order_release)) < reps_to_do) {
+                                // one repetition per thread is always done, so that there is a partition
+                                if (best_cut != std::numeric_limits<EdgeWeight>::max()
+                                    && parallel::deadline_reached(config.deadline)) {
+                                        break;
+                                }
                                 uint32_t seed = rnd.random_number(0u, std::numeric_limits<uint32_t>::max());
                                 PartitionConfig working_config = config;
                                 working_config.combine = false;
 
+                                if (config.initial_partitioning_portfolio) {
+                                        if (global_best_cut.load(std::memory_order_relaxed) == 0
+                                            || (config.initial_partitioning_time_budget > 0
+                                                && best_cut != std::numeric_limits<EdgeWeight>::max()
+                                                && t.elapsed() > config.initial_partitioning_time_budget)) {
+                                                break;
+                                        }
+                                        working_config.bipartition_algorithm = portfolio[rep % portfolio.size()];
+                                }
+
                                 partition.initial_partition(working_config, seed, G, partition_map.get());
 
+                                if (partition.aborted()) {
+                                        reps_cut_off.fetch_add(1, std::memory_order_relaxed);
+                                        continue;
+                                }
+
                                 EdgeWeight cur_cut = qm.edge_cut(G, partition_map.get());
                                 if (cur_cut < best_cut) {
                                         best_map.swap(partition_map);
                                         best_cut = cur_cut;
 
+                                        EdgeWeight global_cut = global_best_cut.load(std::memory_order_relaxed);
+                                        while (best_cut < global_cut
+                                               && !global_best_cut.compare_exchange_weak(global_cut, best_cut,
+                                                                                         std::memory_order_relaxed)) {}
+
                                         if (best_cut == 0) {
                                                 break;
                                         }
@@ -67,48 +114,45 @@ void initial_partitioning::perform_initial_partitioning(const PartitionConfig& c
                 return std::make_pair(best_cut, std::move(best_map));
         };
 
+        // all threads share the nodes and edges of G and only own the partition and edge ratings,
+        // G itself is not modified until the best partition is applied
         auto task = [&] (uint32_t id) {
                 if (id > 0) {
                         random_functions::setSeed(id + config.seed);
-                        graph_access my_graph;
-                        G.copy(my_graph);
-                        return task_impl(my_graph, id);
-                } else {
-                        return task_impl(G, id);
                 }
+                graph_access my_graph;
+                G.share_topology(my_graph);
+                return task_impl(my_graph, id);
         };
 
         std::vector<std::future<std::pair<EdgeWeight, std::unique_ptr<int[]>>>> futures;
-        futures.reserve(g_thread_pool.NumThreads());
+        futures.reserve(current_thread_pool().NumThreads());
 
         // start initial
-        std::ofstream ofs;
-        std::streambuf* backup = std::cout.rdbuf();
-        ofs.open("/dev/null");
-        std::cout.rdbuf(ofs.rdbuf());
+        auto silence = std::make_unique<silent_output>();
 
-        for (uint32_t id = 0; id < g_thread_pool.NumThreads(); ++id) {
-                futures.push_back(parallel::g_thread_pool.Submit(id, task, id + 1));
+        for (uint32_t id = 0; id < current_thread_pool().NumThreads(); ++id) {
+                futures.push_back(parallel::current_thread_pool().Submit(id, task, id + 1));
         }
 
-        EdgeWeight best_cut;
-        std::unique_ptr<int[]> best_map;
+        EdgeWeight best_cut = given_cut;
+        std::unique_ptr<int[]> best_map = std::move(given_map);
 
-        std::tie(best_cut, best_map) = task(0);
+        std::vector<std::pair<EdgeWeight, std::unique_ptr<int[]>>> cuts;
+        cuts.push_back(task(0));
 
         parallel::random rnd(config.seed);
-        std::vector<std::pair<EdgeWeight, std::unique_ptr<int[]>>> cuts;
         std::for_each(futures.begin(), futures.end(), [&](auto& future) {
                 cuts.push_back(future.get());
         });
-        ofs.close();
-        std::cout.rdbuf(backup);
+        silence.reset();
 
         for (auto& cut : cuts) {
                 EdgeWeight cur_cut = cut.first;
                 std::unique_ptr<int[]> cur_map = std::move(cut.second);
 
-                if (cur_cut < best_cut || (cur_cut == best_cut && rnd.bit())) {
+                if (cur_cut < best_cut || (cur_cut == best_cut && cur_cut != std::numeric_limits<EdgeWeight>::max()
+                                           && rnd.bit())) {
                         PRINT(std::cout << "log>"
                                         << "improved the current initial partitiong from "
                                         << best_cut
@@ -119,9 +163,11 @@ void initial_partitioning::perform_initial_partitioning(const PartitionConfig& c
         }
 
         G.set_partition_count(config.k);
-        forall_nodes(G, n) {
-                G.setPartitionIndex(n, best_map[n]);
-        } endfor
+        if (best_map) {
+                forall_nodes(G, n) {
+                        G.setPartitionIndex(n, best_map[n]);
+                } endfor
+        }
 
         PRINT(std::cout << "initial partitioning took " << t.elapsed()                << std::endl;)
         PRINT(std::cout << "log>"                       << "current initial balance " << qm.balance(G) << std::endl;)
@@ -133,6 +179,9 @@ void initial_partitioning::perform_initial_partitioning(const PartitionConfig& c
                 PRINT(std::cout << "log>"             << "final current initial balance " << qm.balance(G) << std::endl;)
         }
         std::cout << "initial cut\t" << best_cut << std::endl;
+        if (config.initial_partitioning_portfolio) {
+                std::cout << "initial partitioning repetitions cut off\t" << reps_cut_off.load() << std::endl;
+        }
 
         ASSERT_TRUE(graph_partition_assertions::assert_graph_has_kway_partition(config, G));
 }
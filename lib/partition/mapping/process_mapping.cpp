@@ -0,0 +1,265 @@
+#include "data_structure/parallel/algorithm.h"
+#include "data_structure/parallel/thread_pool.h"
+#include "data_structure/parallel/time.h"
+#include "data_structure/priority_queues/maxNodeHeap.h"
+#include "mapping/process_mapping.h"
+#include "tools/macros_assertions.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+namespace parallel {
+
+process_mapping::process_mapping(const std::vector<int>& group_sizes, const std::vector<int>& distances) {
+        ALWAYS_ASSERT(!group_sizes.empty() && group_sizes.size() == distances.size());
+
+        PartitionID level_size = 1;
+        for (size_t level = 0; level < group_sizes.size(); ++level) {
+                ALWAYS_ASSERT(group_sizes[level] > 0);
+                level_size *= group_sizes[level];
+                m_level_sizes.push_back(level_size);
+                m_distances.push_back(distances[level]);
+        }
+}
+
+void process_mapping::build_quotient_graph(graph_access& G, graph_access& Q) {
+        const PartitionID k = G.get_partition_count();
+        const uint32_t num_threads = current_thread_pool().NumThreads() + 1;
+
+        // every thread sums up the cut weights of its nodes, the key of a pair of blocks is lhs * k + rhs
+        std::vector<std::unordered_map<uint64_t, EdgeWeight>> thread_cut_weights(num_threads);
+        std::vector<std::vector<NodeWeight>> thread_block_weights(num_threads, std::vector<NodeWeight>(k, 0));
+        parallel_for_index(NodeID(0), G.number_of_nodes(), [&](NodeID node, uint32_t thread_id) {
+                PartitionID block = G.getPartitionIndex(node);
+                thread_block_weights[thread_id][block] += G.getNodeWeight(node);
+                forall_out_edges(G, e, node) {
+                        PartitionID target_block = G.getPartitionIndex(G.getEdgeTarget(e));
+                        if (target_block != block) {
+                                thread_cut_weights[thread_id][(uint64_t) block * k + target_block] += G.getEdgeWeight(e);
+                        }
+                } endfor
+        });
+
+        // thread id owns the blocks lhs with lhs % num_threads == id and merges their edges of all threads
+        std::vector<std::vector<std::pair<PartitionID, EdgeWeight>>> rows(k);
+        std::vector<NodeWeight> block_weights(k, 0);
+        submit_for_all([&](uint32_t id) {
+                for (PartitionID block = id; block < k; block += num_threads) {
+                        for (uint32_t thread_id = 0; thread_id < num_threads; ++thread_id) {
+                                block_weights[block] += thread_block_weights[thread_id][block];
+                        }
+                }
+
+                std::unordered_map<uint64_t, EdgeWeight> cut_weights;
+                for (uint32_t thread_id = 0; thread_id < num_threads; ++thread_id) {
+                        for (const auto& entry : thread_cut_weights[thread_id]) {
+                                if ((entry.first / k) % num_threads == id) {
+                                        cut_weights[entry.first] += entry.second;
+                                }
+                        }
+                }
+
+                for (const auto& entry : cut_weights) {
+                        rows[entry.first / k].emplace_back(entry.first % k, entry.second);
+                }
+                for (PartitionID block = id; block < k; block += num_threads) {
+                        std::sort(rows[block].begin(), rows[block].end());
+                }
+        });
+
+        EdgeID num_edges = 0;
+        for (const auto& row : rows) {
+                num_edges += row.size();
+        }
+
+        Q.start_construction(k, num_edges);
+        for (PartitionID block = 0; block < k; ++block) {
+                NodeID node = Q.new_node();
+                Q.setNodeWeight(node, block_weights[block]);
+                for (const auto& edge : rows[block]) {
+                        EdgeID e = Q.new_edge(node, edge.first);
+                        Q.setEdgeWeight(e, edge.second);
+                }
+        }
+        Q.finish_construction();
+}
+
+void process_mapping::construct_mapping(graph_access& Q, std::vector<PartitionID>& mapping) const {
+        const NodeID k = Q.number_of_nodes();
+        ALWAYS_ASSERT(k == num_pes());
+        mapping.assign(k, INVALID_PARTITION);
+
+        // the free PEs are kept in a dense array so that a PE is removed in constant time
+        std::vector<PartitionID> free_pes(k);
+        std::vector<PartitionID> free_positions(k);
+        std::iota(free_pes.begin(), free_pes.end(), 0);
+        std::iota(free_positions.begin(), free_positions.end(), 0);
+
+        // the block with the heaviest communication is mapped first, the following blocks are the ones
+        // with the heaviest communication to mapped blocks
+        NodeID block = 0;
+        EdgeWeight max_communication = -1;
+        forall_nodes(Q, node) {
+                EdgeWeight communication = 0;
+                forall_out_edges(Q, e, node) {
+                        communication += Q.getEdgeWeight(e);
+                } endfor
+                if (communication > max_communication) {
+                        max_communication = communication;
+                        block = node;
+                }
+        } endfor
+
+        maxNodeHeap queue;
+        forall_nodes(Q, node) {
+                if (node != block) {
+                        queue.insert(node, 0);
+                }
+        } endfor
+
+        const uint32_t num_threads = current_thread_pool().NumThreads() + 1;
+        std::vector<std::pair<PartitionID, EdgeWeight>> mapped_neighbors;
+        std::vector<std::pair<cost_type, PartitionID>> thread_best(num_threads);
+        while (true) {
+                mapped_neighbors.clear();
+                forall_out_edges(Q, e, block) {
+                        NodeID target = Q.getEdgeTarget(e);
+                        if (mapping[target] != INVALID_PARTITION) {
+                                mapped_neighbors.emplace_back(mapping[target], Q.getEdgeWeight(e));
+                        }
+                } endfor
+
+                // the block gets the free PE with the smallest communication cost, ties are broken by the PE id
+                auto evaluate = [&](size_t index, uint32_t thread_id) {
+                        PartitionID pe = free_pes[index];
+                        cost_type cost = 0;
+                        for (const auto& neighbor : mapped_neighbors) {
+                                cost += neighbor.second * distance(pe, neighbor.first);
+                        }
+                        thread_best[thread_id] = std::min(thread_best[thread_id], std::make_pair(cost, pe));
+                };
+
+                std::fill(thread_best.begin(), thread_best.end(),
+                          std::make_pair(std::numeric_limits<cost_type>::max(), INVALID_PARTITION));
+                if ((uint64_t) free_pes.size() * mapped_neighbors.size() >= min_parallel_work) {
+                        parallel_for_index(size_t(0), free_pes.size(), evaluate);
+                } else {
+                        for (size_t index = 0; index < free_pes.size(); ++index) {
+                                evaluate(index, 0);
+                        }
+                }
+                PartitionID best_pe = std::min_element(thread_best.begin(), thread_best.end())->second;
+
+                mapping[block] = best_pe;
+                PartitionID position = free_positions[best_pe];
+                free_pes[position] = free_pes.back();
+                free_positions[free_pes[position]] = position;
+                free_pes.pop_back();
+
+                forall_out_edges(Q, e, block) {
+                        NodeID target = Q.getEdgeTarget(e);
+                        if (queue.contains(target)) {
+                                queue.increaseKey(target, queue.getKey(target) + Q.getEdgeWeight(e));
+                        }
+                } endfor
+
+                if (queue.empty()) {
+                        break;
+                }
+                block = queue.deleteMax();
+        }
+}
+
+process_mapping::cost_type process_mapping::perform_local_search(const PartitionConfig& config, graph_access& Q,
+                                                                 std::vector<PartitionID>& mapping) const {
+        struct swap_candidate {
+                cost_type gain;
+                NodeID lhs;
+                NodeID rhs;
+        };
+
+        const uint32_t num_threads = current_thread_pool().NumThreads() + 1;
+        cost_type total_improvement = 0;
+        for (uint32_t round = 0; round < max_local_search_rounds; ++round) {
+                if (deadline_reached(config.deadline)) {
+                        break;
+                }
+
+                // the swaps of all adjacent blocks are evaluated concurrently
+                std::vector<std::vector<swap_candidate>> thread_candidates(num_threads);
+                parallel_for_index(NodeID(0), Q.number_of_nodes(), [&](NodeID lhs, uint32_t thread_id) {
+                        forall_out_edges(Q, e, lhs) {
+                                NodeID rhs = Q.getEdgeTarget(e);
+                                if (lhs < rhs) {
+                                        cost_type gain = swap_gain(Q, mapping, lhs, rhs);
+                                        if (gain > 0) {
+                                                thread_candidates[thread_id].push_back({gain, lhs, rhs});
+                                        }
+                                }
+                        } endfor
+                });
+
+                std::vector<swap_candidate> candidates;
+                for (auto& cur_candidates : thread_candidates) {
+                        candidates.insert(candidates.end(), cur_candidates.begin(), cur_candidates.end());
+                }
+                std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+                        return a.gain > b.gain || (a.gain == b.gain && std::make_pair(a.lhs, a.rhs) < std::make_pair(b.lhs, b.rhs));
+                });
+
+                // earlier swaps change the gains of later ones, so every swap is evaluated again before it is done
+                cost_type round_improvement = 0;
+                for (const auto& candidate : candidates) {
+                        cost_type gain = swap_gain(Q, mapping, candidate.lhs, candidate.rhs);
+                        if (gain > 0) {
+                                std::swap(mapping[candidate.lhs], mapping[candidate.rhs]);
+                                round_improvement += gain;
+                        }
+                }
+
+                total_improvement += round_improvement;
+                if (round_improvement == 0) {
+                        break;
+                }
+        }
+        return total_improvement;
+}
+
+process_mapping::cost_type process_mapping::objective(graph_access& Q, const std::vector<PartitionID>& mapping) const {
+        std::vector<cost_type> thread_costs(current_thread_pool().NumThreads() + 1, 0);
+        parallel_for_index(NodeID(0), Q.number_of_nodes(), [&](NodeID block, uint32_t thread_id) {
+                forall_out_edges(Q, e, block) {
+                        NodeID target = Q.getEdgeTarget(e);
+                        thread_costs[thread_id] += Q.getEdgeWeight(e) * distance(mapping[block], mapping[target]);
+                } endfor
+        });
+
+        // every pair of blocks is counted from both sides
+        return std::accumulate(thread_costs.begin(), thread_costs.end(), cost_type(0)) / 2;
+}
+
+process_mapping::cost_type process_mapping::swap_gain(graph_access& Q, const std::vector<PartitionID>& mapping,
+                                                      NodeID lhs, NodeID rhs) const {
+        PartitionID lhs_pe = mapping[lhs];
+        PartitionID rhs_pe = mapping[rhs];
+
+        // the cost of the edge between lhs and rhs does not change
+        cost_type gain = 0;
+        forall_out_edges(Q, e, lhs) {
+                NodeID target = Q.getEdgeTarget(e);
+                if (target != rhs) {
+                        gain += Q.getEdgeWeight(e) * (distance(lhs_pe, mapping[target]) - distance(rhs_pe, mapping[target]));
+                }
+        } endfor
+        forall_out_edges(Q, e, rhs) {
+                NodeID target = Q.getEdgeTarget(e);
+                if (target != lhs) {
+                        gain += Q.getEdgeWeight(e) * (distance(rhs_pe, mapping[target]) - distance(lhs_pe, mapping[target]));
+                }
+        } endfor
+        return gain;
+}
+
+}
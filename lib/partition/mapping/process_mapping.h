@@ -0,0 +1,63 @@
+#pragma once
+
+#include "data_structure/graph_access.h"
+#include "partition_config.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace parallel {
+
+// Maps the blocks of a partition onto the PEs of a hierarchical machine. group_sizes[i] groups of level i form a
+// group of level i + 1, the PEs are the groups of level 0. Two PEs whose smallest common group is on level i + 1
+// have distance distances[i]. The mapping minimizes the sum over all pairs of blocks of their cut weight times the
+// distance of their PEs.
+class process_mapping {
+public:
+        using cost_type = int64_t;
+
+        process_mapping(const std::vector<int>& group_sizes, const std::vector<int>& distances);
+
+        PartitionID num_pes() const {
+                return m_level_sizes.back();
+        }
+
+        inline cost_type distance(PartitionID lhs, PartitionID rhs) const {
+                if (lhs == rhs) {
+                        return 0;
+                }
+                for (size_t level = 0; level < m_level_sizes.size(); ++level) {
+                        if (lhs / m_level_sizes[level] == rhs / m_level_sizes[level]) {
+                                return m_distances[level];
+                        }
+                }
+                return m_distances.back();
+        }
+
+        // the nodes of Q are the blocks of G weighted by the block weights, the edges are weighted by the cut weights
+        static void build_quotient_graph(graph_access& G, graph_access& Q);
+
+        // mapping[block] is the PE of the block
+        void construct_mapping(graph_access& Q, std::vector<PartitionID>& mapping) const;
+
+        // swaps the PEs of adjacent blocks while the objective improves, returns the improvement
+        cost_type perform_local_search(const PartitionConfig& config, graph_access& Q,
+                                       std::vector<PartitionID>& mapping) const;
+
+        cost_type objective(graph_access& Q, const std::vector<PartitionID>& mapping) const;
+
+private:
+        static constexpr uint32_t max_local_search_rounds = 100;
+        // the free PEs of a block are only evaluated in parallel if this much work is to be done
+        static constexpr uint64_t min_parallel_work = 1 << 14;
+
+        // reduction of the objective if lhs and rhs exchange their PEs
+        cost_type swap_gain(graph_access& Q, const std::vector<PartitionID>& mapping,
+                            NodeID lhs, NodeID rhs) const;
+
+        // number of PEs in a group of level i + 1
+        std::vector<PartitionID> m_level_sizes;
+        std::vector<cost_type> m_distances;
+};
+
+}
@@ -0,0 +1,67 @@
+#include "node_ordering/min_degree_ordering.h"
+
+#include <algorithm>
+#include <limits>
+
+void min_degree_ordering::perform_ordering(graph_access& G, std::vector<NodeID>& order) {
+        const NodeID n = G.number_of_nodes();
+        order.clear();
+        order.reserve(n);
+
+        std::vector<std::vector<NodeID>> adjacency(n);
+        forall_nodes(G, node) {
+                forall_out_edges(G, e, node) {
+                        NodeID target = G.getEdgeTarget(e);
+                        if (target != node) {
+                                adjacency[node].push_back(target);
+                        }
+                } endfor
+                std::sort(adjacency[node].begin(), adjacency[node].end());
+                adjacency[node].erase(std::unique(adjacency[node].begin(), adjacency[node].end()),
+                                      adjacency[node].end());
+        } endfor
+
+        std::vector<bool> eliminated(n, false);
+        std::vector<NodeID> marker(n, std::numeric_limits<NodeID>::max());
+        for (NodeID step = 0; step < n; ++step) {
+                // ties are broken by the node id, so the ordering is deterministic
+                NodeID pivot = std::numeric_limits<NodeID>::max();
+                for (NodeID node = 0; node < n; ++node) {
+                        if (!eliminated[node]
+                            && (pivot == std::numeric_limits<NodeID>::max()
+                                || adjacency[node].size() < adjacency[pivot].size())) {
+                                pivot = node;
+                        }
+                }
+
+                eliminated[pivot] = true;
+                order.push_back(pivot);
+
+                // the neighbors of the pivot become a clique
+                std::vector<NodeID> neighbors;
+                neighbors.swap(adjacency[pivot]);
+                for (NodeID neighbor : neighbors) {
+                        marker[neighbor] = pivot;
+                }
+                for (NodeID neighbor : neighbors) {
+                        std::vector<NodeID>& adj = adjacency[neighbor];
+                        adj.erase(std::remove(adj.begin(), adj.end(), pivot), adj.end());
+                        for (NodeID other : adj) {
+                                if (marker[other] == pivot) {
+                                        marker[other] = n + pivot;
+                                }
+                        }
+                        for (NodeID other : neighbors) {
+                                if (other != neighbor && marker[other] == pivot) {
+                                        adj.push_back(other);
+                                }
+                        }
+                        // reset the marks of the neighbors that were already adjacent
+                        for (NodeID other : adj) {
+                                if (marker[other] == n + pivot) {
+                                        marker[other] = pivot;
+                                }
+                        }
+                }
+        }
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "data_structure/graph_access.h"
+
+#include <vector>
+
+// Minimum degree ordering on the explicit elimination graph. The elimination graph can become dense, so this
+// is only meant for the small leaves of the nested dissection.
+class min_degree_ordering {
+public:
+        // order contains the nodes of G in elimination order
+        void perform_ordering(graph_access& G, std::vector<NodeID>& order);
+};
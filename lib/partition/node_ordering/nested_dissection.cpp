@@ -0,0 +1,196 @@
+#include "data_structure/parallel/silent_output.h"
+#include "data_structure/parallel/thread_pool.h"
+#include "graph_partitioner.h"
+#include "node_ordering/min_degree_ordering.h"
+#include "node_ordering/nested_dissection.h"
+#include "random_functions.h"
+#include "tools/graph_extractor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <numeric>
+
+namespace parallel {
+
+void nested_dissection::perform_nested_dissection(const PartitionConfig& config, graph_access& G,
+                                                  std::vector<NodeID>& ordering) {
+        ordering.resize(G.number_of_nodes());
+        std::vector<NodeID> global_ids(G.number_of_nodes());
+        std::iota(global_ids.begin(), global_ids.end(), 0);
+
+        // the pending subgraphs are balanced between the threads, so there should be some more than threads
+        const uint32_t num_threads = current_thread_pool().NumThreads() + 1;
+        m_parallel_depth = 0;
+        while (num_threads > 1 && (1u << m_parallel_depth) < 2 * num_threads) {
+                ++m_parallel_depth;
+        }
+        m_pending.clear();
+
+        silent_output silence;
+        dissect(config, G, global_ids, 0, ordering, 0);
+        if (m_pending.empty()) {
+                return;
+        }
+
+        // every thread dissects its own subgraphs, so the partitioner must not use the thread pool
+        PartitionConfig sequential_config               = config;
+        sequential_config.parallel_multitry_kway        = false;
+        sequential_config.parallel_initial_partitioning = false;
+        sequential_config.parallel_lp                   = false;
+        sequential_config.parallel_coarsening_lp        = false;
+        sequential_config.lp_before_local_search        = false;
+        sequential_config.deep_multilevel               = false;
+        sequential_config.fast_contract_clustering      = false;
+        sequential_config.parallel_node_separator       = false;
+
+        std::sort(m_pending.begin(), m_pending.end(), [](const subproblem& lhs, const subproblem& rhs) {
+                return lhs.graph->number_of_nodes() > rhs.graph->number_of_nodes();
+        });
+
+        std::atomic<size_t> next(0);
+        auto task = [&](uint32_t id) {
+                random_functions::setSeed(config.seed + id);
+                size_t index;
+                while ((index = next.fetch_add(1, std::memory_order_relaxed)) < m_pending.size()) {
+                        subproblem& sub = m_pending[index];
+                        // subgraphs below the parallel depth never become pending again
+                        dissect(sequential_config, *sub.graph, sub.global_ids, sub.first_position, ordering,
+                                m_parallel_depth);
+                        sub.graph.reset();
+                }
+        };
+
+        std::vector<std::future<void>> futures;
+        futures.reserve(current_thread_pool().NumThreads());
+        for (uint32_t id = 0; id < current_thread_pool().NumThreads(); ++id) {
+                futures.push_back(current_thread_pool().Submit(id, task, id + 1));
+        }
+        task(0);
+        std::for_each(futures.begin(), futures.end(), [&](auto& future) {
+                future.get();
+        });
+        m_pending.clear();
+}
+
+void nested_dissection::dissect(const PartitionConfig& config, graph_access& G, const std::vector<NodeID>& global_ids,
+                                NodeID first_position, std::vector<NodeID>& ordering, uint32_t depth) {
+        subproblem lhs;
+        subproblem rhs;
+        // only the top levels run on the main thread while the thread pool is idle
+        const bool parallel_extraction = depth < m_parallel_depth;
+        if (!split(config, G, global_ids, first_position, ordering, parallel_extraction, lhs, rhs)) {
+                return;
+        }
+
+        for (subproblem* sub : {&lhs, &rhs}) {
+                if (depth + 1 == m_parallel_depth) {
+                        m_pending.push_back(std::move(*sub));
+                } else {
+                        dissect(config, *sub->graph, sub->global_ids, sub->first_position, ordering, depth + 1);
+                        sub->graph.reset();
+                }
+        }
+}
+
+bool nested_dissection::split(const PartitionConfig& config, graph_access& G, const std::vector<NodeID>& global_ids,
+                              NodeID first_position, std::vector<NodeID>& ordering, bool parallel_extraction,
+                              subproblem& lhs, subproblem& rhs) {
+        const bool small_leaf = G.number_of_nodes() <= std::max<NodeID>(config.dissection_rec_limit, 2);
+        auto order_leaf = [&]() {
+                // minimum degree is quadratic in the worst case, large leaves are left by failed splits
+                // and edgeless leaves gain nothing from it, both keep their natural order
+                if (!small_leaf || G.number_of_edges() == 0) {
+                        forall_nodes(G, node) {
+                                ordering[global_ids[node]] = first_position + node;
+                        } endfor
+                        return;
+                }
+
+                min_degree_ordering mdo;
+                std::vector<NodeID> order;
+                mdo.perform_ordering(G, order);
+                for (NodeID i = 0; i < order.size(); ++i) {
+                        ordering[global_ids[order[i]]] = first_position + i;
+                }
+        };
+
+        if (small_leaf || G.number_of_edges() == 0) {
+                order_leaf();
+                return false;
+        }
+
+        compute_separator(config, G);
+
+        const PartitionID separator = G.getSeparatorBlock();
+        std::vector<NodeID> block_nodes[3];
+        std::vector<NodeID> local_ids(G.number_of_nodes());
+        forall_nodes(G, node) {
+                PartitionID block = G.getPartitionIndex(node) == separator ? 2 : G.getPartitionIndex(node);
+                local_ids[node] = block_nodes[block].size();
+                block_nodes[block].push_back(node);
+        } endfor
+
+        // no progress, e.g. on a clique
+        if (block_nodes[0].empty() || block_nodes[1].empty()) {
+                order_leaf();
+                return false;
+        }
+
+        NodeID position = first_position + block_nodes[0].size() + block_nodes[1].size();
+        for (NodeID node : block_nodes[2]) {
+                ordering[global_ids[node]] = position++;
+        }
+
+        graph_extractor extractor;
+        NodeID next_first_position = first_position;
+        PartitionID block = 0;
+        for (subproblem* sub : {&lhs, &rhs}) {
+                sub->graph = std::make_unique<graph_access>();
+                if (parallel_extraction) {
+                        extractor.parallel_extract_block(G, *sub->graph, block, block_nodes[block], local_ids);
+                } else {
+                        extractor.extract_block(G, *sub->graph, block, block_nodes[block], local_ids);
+                }
+
+                sub->global_ids.resize(block_nodes[block].size());
+                for (NodeID i = 0; i < block_nodes[block].size(); ++i) {
+                        sub->global_ids[i] = global_ids[block_nodes[block][i]];
+                }
+                sub->first_position = next_first_position;
+
+                next_first_position += block_nodes[block].size();
+                ++block;
+        }
+        return true;
+}
+
+void nested_dissection::compute_separator(const PartitionConfig& config, graph_access& G) {
+        PartitionConfig separator_config = config;
+        separator_config.k = 2;
+        G.set_partition_count(separator_config.k);
+
+        // block weight bound as in balance_configuration, node separators do not balance edges
+        NodeWeight graph_weight = 0;
+        forall_nodes(G, node) {
+                graph_weight += G.getNodeWeight(node);
+        } endfor
+
+        double epsilon = config.imbalance/100.0;
+        if (config.imbalance == 0) {
+                separator_config.upper_bound_partition    = (1+epsilon+0.01)*ceil(graph_weight/2.0);
+                separator_config.kaffpa_perfectly_balance = true;
+        } else {
+                separator_config.upper_bound_partition = (1+epsilon)*ceil(graph_weight/2.0);
+        }
+        separator_config.largest_graph_weight       = graph_weight;
+        separator_config.work_load                  = graph_weight;
+        separator_config.graph_allready_partitioned = false;
+        separator_config.kway_adaptive_limits_beta  = log(G.number_of_nodes());
+        separator_config.mode_node_separators       = true;
+
+        graph_partitioner partitioner;
+        partitioner.perform_partitioning(separator_config, G);
+}
+
+}
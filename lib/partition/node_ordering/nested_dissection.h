@@ -0,0 +1,41 @@
+#pragma once
+
+#include "data_structure/graph_access.h"
+#include "partition_config.h"
+
+#include <memory>
+#include <vector>
+
+namespace parallel {
+
+// Computes a fill reducing ordering by recursive node separators. The separator of a subgraph gets the
+// highest positions of the range of its subgraph. The separators of the first levels are computed with the
+// parallel pipeline one after another, the remaining subgraphs are dissected concurrently by the threads.
+// Small subgraphs are ordered by minimum degree.
+class nested_dissection {
+public:
+        // ordering[v] is the position of node v in the elimination order
+        void perform_nested_dissection(const PartitionConfig& config, graph_access& G, std::vector<NodeID>& ordering);
+
+private:
+        struct subproblem {
+                std::unique_ptr<graph_access> graph;
+                std::vector<NodeID> global_ids;
+                NodeID first_position;
+        };
+
+        void dissect(const PartitionConfig& config, graph_access& G, const std::vector<NodeID>& global_ids,
+                     NodeID first_position, std::vector<NodeID>& ordering, uint32_t depth);
+
+        // returns false if G is ordered as a leaf
+        bool split(const PartitionConfig& config, graph_access& G, const std::vector<NodeID>& global_ids,
+                   NodeID first_position, std::vector<NodeID>& ordering, bool parallel_extraction,
+                   subproblem& lhs, subproblem& rhs);
+
+        void compute_separator(const PartitionConfig& config, graph_access& G);
+
+        uint32_t m_parallel_depth = 0;
+        std::vector<subproblem> m_pending;
+};
+
+}
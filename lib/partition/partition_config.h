@@ -432,6 +432,35 @@ struct PartitionConfig
         bool remove_edges_in_matching  = false;
         MultitryKwayLoopStoppingRule multitry_kway_global_loop_stopping_rule = MultitryKwayLoopStoppingRule::ITERATION;
         MultitryKwayLoopStoppingRule multitry_kway_local_loop_stopping_rule = MultitryKwayLoopStoppingRule::PERCENTAGE;
+        bool use_fast_bucket_queues = false;
+        bool lp_block_weight_reservations = false;
+        uint32_t lp_reservation_batch_divisor = 4;
+        uint32_t recursive_bipartitioning_threads = 1;
+        bool initial_partitioning_portfolio = false;
+        double initial_partitioning_time_budget = 0;
+        bool deep_multilevel = false;
+        NodeID deep_multilevel_nodes_per_block = 60;
+        std::string edge_delta;
+        uint32_t incremental_hops = 2;
+        std::vector<PartitionID> batch_k;
+        // point in time of parallel::steady_time() after which all phases stop and keep the best partition so far, 0 means no deadline
+        double deadline = 0;
+        bool parallel_node_separator = false;
+        uint32_t sep_num_lp_rounds = 16;
+        NodeID dissection_rec_limit = 120;
+        std::string ordering_output;
+        bool compare_serial_ordering = false;
+        // searches block pairs of the augmented quotient graph with the thread pool, only for the main thread
+        bool parallel_cycle_refinement = false;
+        // the galinier combine and the tabu search of the evolutionary algorithm use the thread pool, only for the main thread
+        bool parallel_combine_operators = false;
+        // objective of the parallel multitry kway fm and the parallel label propagation refinement
+        RefinementObjective refinement_objective = RefinementObjective::CUT;
+        // maps the blocks onto the PEs of a hierarchical machine after partitioning, group_sizes[i] groups of
+        // level i form a group of level i + 1 and distances[i] is the distance of two PEs in the same group of level i + 1
+        bool enable_mapping = false;
+        std::vector<int> group_sizes;
+        std::vector<int> distances;
         //bool accept_small_coarser_graphs = false;
 };
 
@@ -1,40 +1,64 @@
+#include "data_structure/parallel/algorithm.h"
+#include "data_structure/parallel/silent_output.h"
 #include "data_structure/parallel/time.h"
+#include "initial_partitioning/initial_partition_bipartition.h"
 #include "partition/uncoarsening/parallel_uncoarsening.h"
+#include "partition/uncoarsening/refinement/node_separators/parallel_lp_ns_local_search.h"
 #include "partition/uncoarsening/refinement/label_propagation_refinement/label_propagation_refinement.h"
 #include "partition/uncoarsening/refinement/parallel_kway_graph_refinement/multitry_kway_fm.h"
+#include "tools/graph_extractor.h"
 #include "tools/graph_partition_assertions.h"
 #include "tools/quality_metrics.h"
+#include "tools/random_functions.h"
 
+#include <cmath>
 #include <memory>
 
 namespace parallel {
 
 int uncoarsening::perform_uncoarsening_cut(const PartitionConfig& config, graph_hierarchy& hierarchy) {
         PartitionConfig cfg = config;
-        std::unique_ptr<graph_access> coarsest(hierarchy.get_coarsest());
+        graph_access* coarsest = hierarchy.get_coarsest();
+        std::unique_ptr<graph_access> coarsest_owner(hierarchy.is_persistent() ? nullptr : coarsest);
         PRINT(std::cout << "log>" << "unrolling graph with " << coarsest->number_of_nodes() << std::endl;)
 
+        // in deep multilevel mode the number of blocks grows during uncoarsening
+        NodeWeight upper_bound = config.upper_bound_partition;
+        if (config.deep_multilevel) {
+                PartitionID target_k = hierarchy.isEmpty() ? config.k
+                                                           : deep_multilevel_num_blocks(config, coarsest->number_of_nodes());
+                if (coarsest->get_partition_count() < target_k) {
+                        CLOCK_START;
+                        split_blocks(config, *coarsest, target_k);
+                        CLOCK_END(">> Split blocks");
+                }
+                cfg.k = coarsest->get_partition_count();
+                upper_bound = deep_multilevel_upper_bound(config, cfg.k);
+        }
+
+        double factor = config.balance_factor;
+        cfg.upper_bound_partition = ((!hierarchy.isEmpty()) * factor + 1.0) * upper_bound;
+
         if (config.lp_before_local_search) {
                 CLOCK_START;
                 perform_label_propagation(cfg, *coarsest);
                 CLOCK_END(">> Uncoarsening: Label propagation");
         }
 
-        double factor = config.balance_factor;
-        cfg.upper_bound_partition = ((!hierarchy.isEmpty()) * factor + 1.0) * config.upper_bound_partition;
-
         EdgeWeight improvement = 0;
+        // the boundary is built once for the coarsest graph and then projected to finer levels
+        std::unique_ptr<boundary_type> boundary;
         if (config.parallel_multitry_kway) {
                 CLOCK_START;
-                boundary_type boundary(*coarsest, cfg);
-                boundary.construct_boundary();
+                boundary = std::make_unique<boundary_type>(*coarsest, cfg);
+                boundary->construct_boundary();
                 if (config.check_cut) {
-                        boundary.check_boundary();
+                        boundary->check_boundary();
                 }
                 CLOCK_END(">> Build boundary");
 
                 CLOCK_START_N;
-                improvement += perform_multitry_kway(cfg, *coarsest, boundary);
+                improvement += perform_multitry_kway(cfg, *coarsest, *boundary);
                 CLOCK_END(">> Refinement");
         }
 
@@ -48,34 +72,54 @@ int uncoarsening::perform_uncoarsening_cut(const PartitionConfig& config, graph_
 
                 PRINT(std::cout << "log>" << "unrolling graph with " << G->number_of_nodes() << std::endl;)
 
-                if (config.lp_before_local_search) {
-                        CLOCK_START_N;
-                        perform_label_propagation(cfg, *G);
-                        CLOCK_END(">> Uncoarsening: Label propagation");
+                bool blocks_split = false;
+                if (config.deep_multilevel) {
+                        PartitionID target_k = hierarchy.isEmpty() ? config.k
+                                                                   : deep_multilevel_num_blocks(config, G->number_of_nodes());
+                        if (G->get_partition_count() < target_k) {
+                                CLOCK_START_N;
+                                split_blocks(config, *G, target_k);
+                                CLOCK_END(">> Split blocks");
+                                blocks_split = true;
+                        }
+                        cfg.k = G->get_partition_count();
+                        upper_bound = deep_multilevel_upper_bound(config, cfg.k);
                 }
 
                 //call refinement
                 double cur_factor = factor / (hierarchy_deepth - hierarchy.size());
-                cfg.upper_bound_partition = ((!hierarchy.isEmpty()) * cur_factor + 1.0) * config.upper_bound_partition;
+                cfg.upper_bound_partition = ((!hierarchy.isEmpty()) * cur_factor + 1.0) * upper_bound;
                 PRINT(std::cout << "cfg upperbound " << cfg.upper_bound_partition << std::endl;)
 
+                if (config.lp_before_local_search) {
+                        CLOCK_START_N;
+                        perform_label_propagation(cfg, *G);
+                        CLOCK_END(">> Uncoarsening: Label propagation");
+                }
+
                 if (config.parallel_multitry_kway) {
                         CLOCK_START_N;
-                        boundary_type boundary(*G, cfg);
-                        boundary.construct_boundary();
+                        auto finer_boundary = std::make_unique<boundary_type>(*G, cfg);
+                        if (config.lp_before_local_search || blocks_split) {
+                                // label propagation or splitting moved vertices, so the projected boundary is not valid
+                                finer_boundary->construct_boundary();
+                        } else {
+                                finer_boundary->project(*boundary, *hierarchy.get_mapping_of_current_finer());
+                        }
+                        boundary = std::move(finer_boundary);
                         if (config.check_cut) {
-                                boundary.check_boundary();
+                                boundary->check_boundary();
                         }
-                        CLOCK_END(">> Build boundary");
+                        CLOCK_END(">> Project boundary");
 
                         CLOCK_START_N;
-                        improvement += perform_multitry_kway(cfg, *G, boundary);
+                        improvement += perform_multitry_kway(cfg, *G, *boundary);
                         CLOCK_END(">> Refinement");
                 }
 
-                ASSERT_TRUE(graph_partition_assertions::assert_graph_has_kway_partition(config, *G));
+                ASSERT_TRUE(graph_partition_assertions::assert_graph_has_kway_partition(cfg, *G));
 
-                if (!hierarchy.isEmpty()) {
+                if (!hierarchy.isEmpty() && !hierarchy.is_persistent()) {
                         graphs_to_delete.emplace_back(G);
                 }
         }
@@ -83,23 +127,131 @@ int uncoarsening::perform_uncoarsening_cut(const PartitionConfig& config, graph_
         return improvement;
 }
 
+int uncoarsening::perform_uncoarsening_nodeseparator(const PartitionConfig& config, graph_hierarchy& hierarchy) {
+        graph_access* coarsest = hierarchy.get_coarsest();
+        std::unique_ptr<graph_access> coarsest_owner(hierarchy.is_persistent() ? nullptr : coarsest);
+        PRINT(std::cout << "log>" << "unrolling graph with " << coarsest->number_of_nodes() << std::endl;)
+
+        lp_ns_local_search refinement;
+        NodeWeight improvement = 0;
+
+        CLOCK_START;
+        improvement += refinement.perform_refinement(config, *coarsest);
+        CLOCK_END(">> Separator refinement");
+
+        std::vector<std::unique_ptr<graph_access>> graphs_to_delete;
+        while (!hierarchy.isEmpty()) {
+                CLOCK_START;
+                graph_access* G = hierarchy.parallel_pop_finer_and_project();
+                CLOCK_END("Projection");
+
+                PRINT(std::cout << "log>" << "unrolling graph with " << G->number_of_nodes() << std::endl;)
+
+                CLOCK_START_N;
+                improvement += refinement.perform_refinement(config, *G);
+                CLOCK_END(">> Separator refinement");
+
+                if (!hierarchy.isEmpty() && !hierarchy.is_persistent()) {
+                        graphs_to_delete.emplace_back(G);
+                }
+        }
+
+        return improvement;
+}
+
+PartitionID uncoarsening::deep_multilevel_num_blocks(const PartitionConfig& config, NodeID num_nodes) {
+        PartitionID k = std::min<PartitionID>(2, config.k);
+        while (2 * k <= config.k && num_nodes / (2 * k) >= config.deep_multilevel_nodes_per_block) {
+                k *= 2;
+        }
+        return k;
+}
+
+NodeWeight uncoarsening::deep_multilevel_upper_bound(const PartitionConfig& config, PartitionID k) {
+        // config.k is a multiple of k, so the relative imbalance stays the same
+        return config.upper_bound_partition * (config.k / k);
+}
+
+void uncoarsening::split_blocks(const PartitionConfig& config, graph_access& G, PartitionID target_k) {
+        std::vector<PartitionID> new_partition(G.number_of_nodes());
+        std::vector<NodeID> local_ids(G.number_of_nodes());
+        double epsilon = config.imbalance / 100.0;
+
+        // the bisections run quietly, every thread would print its whole multilevel log otherwise
+        silent_output silence;
+
+        while (G.get_partition_count() < target_k) {
+                PartitionID k = G.get_partition_count();
+
+                std::vector<std::vector<NodeID>> block_nodes(k);
+                forall_nodes(G, node) {
+                        auto& nodes = block_nodes[G.getPartitionIndex(node)];
+                        local_ids[node] = nodes.size();
+                        nodes.push_back(node);
+                } endfor
+
+                // G is only read while the blocks are bisected, the new blocks are applied afterwards
+                std::atomic<PartitionID> next_block(0);
+                parallel::submit_for_all([&](uint32_t) {
+                        PartitionID block;
+                        while ((block = next_block.fetch_add(1, std::memory_order_relaxed)) < k) {
+                                const auto& nodes = block_nodes[block];
+                                std::vector<int> partition_map(nodes.size(), 0);
+
+                                if (nodes.size() > 1) {
+                                        graph_access block_graph;
+                                        graph_extractor().extract_block(G, block_graph, block, nodes, local_ids);
+
+                                        PartitionConfig bipart_config = config;
+                                        bipart_config.k = 2;
+                                        bipart_config.work_load = 0;
+                                        forall_nodes(block_graph, node) {
+                                                bipart_config.work_load += block_graph.getNodeWeight(node);
+                                        } endfor
+                                        bipart_config.upper_bound_partition = std::ceil((1 + epsilon) * bipart_config.work_load / 2.0);
+                                        // the other threads are busy with other blocks
+                                        bipart_config.num_threads = 1;
+
+                                        // the result does not depend on the thread which bisects the block
+                                        random_functions::setSeed(config.seed + k + block);
+                                        initial_partition_bipartition().initial_partition(bipart_config, config.seed + k + block,
+                                                                                          block_graph, partition_map.data());
+                                }
+
+                                for (size_t i = 0; i < nodes.size(); ++i) {
+                                        new_partition[nodes[i]] = 2 * block + partition_map[i];
+                                }
+                        }
+                });
+
+                parallel::parallel_for_index(NodeID(0), G.number_of_nodes(), [&](NodeID node) {
+                        G.setPartitionIndex(node, new_partition[node]);
+                });
+                G.set_partition_count(2 * k);
+        }
+}
+
 void uncoarsening::perform_label_propagation(PartitionConfig& config, graph_access& G) {
         quality_metrics qm;
         EdgeWeight old_cut = 0;
+        // the cut is reported in the objective of the refinement
+        const bool volume_objective = config.refinement_objective == RefinementObjective::COMMUNICATION_VOLUME;
         if (config.check_cut) {
-                old_cut = qm.edge_cut(G);
+                partition_metrics metrics = qm.parallel_metrics(G);
+                old_cut = volume_objective ? metrics.total_communication_volume : metrics.edge_cut;
                 std::cout << "before\t" << old_cut << std::endl;
                 std::cout << "upper_bound_partition\t" << config.upper_bound_partition << std::endl;
-                std::cout << "before balance\t" << qm.balance(G) << std::endl;
+                std::cout << "before balance\t" << metrics.balance << std::endl;
         }
 
-        EdgeWeight changed = label_propagation_refinement().perform_refinement(config, G);
+        EdgeWeight changed = m_label_propagation.perform_refinement(config, G);
 
         if (config.check_cut) {
-                EdgeWeight new_cut = qm.edge_cut(G);
+                partition_metrics metrics = qm.parallel_metrics(G);
+                EdgeWeight new_cut = volume_objective ? metrics.total_communication_volume : metrics.edge_cut;
                 std::cout << "after\t" << new_cut << std::endl;
                 std::cout << "upper_bound_partition\t" << config.upper_bound_partition << std::endl;
-                std::cout << "after balance\t" << qm.balance(G) << std::endl;
+                std::cout << "after balance\t" << metrics.balance << std::endl;
                 std::cout << "changed\t" << changed << std::endl;
         }
 }
@@ -109,9 +261,12 @@ EdgeWeight uncoarsening::perform_multitry_kway(PartitionConfig& config, graph_ac
         quality_metrics qm;
         EdgeWeight old_cut = 0;
         double old_balance = 0.0;
+        // the improvement is measured in the objective of the refinement
+        const bool volume_objective = config.refinement_objective == RefinementObjective::COMMUNICATION_VOLUME;
         if (config.check_cut) {
-                old_cut = qm.edge_cut(G);
-                old_balance = qm.balance(G);
+                partition_metrics metrics = qm.parallel_metrics(G);
+                old_cut = volume_objective ? metrics.total_communication_volume : metrics.edge_cut;
+                old_balance = metrics.balance;
                 std::cout << "before cut\t" << old_cut << std::endl;
                 std::cout << "balance before\t" << old_balance << std::endl;
         }
@@ -121,8 +276,9 @@ EdgeWeight uncoarsening::perform_multitry_kway(PartitionConfig& config, graph_ac
                                                                   true, config.kway_adaptive_limits_alpha);
 
         if (config.check_cut) {
-                EdgeWeight new_cut = qm.edge_cut(G);
-                double new_balance = qm.balance(G);
+                partition_metrics metrics = qm.parallel_metrics(G);
+                EdgeWeight new_cut = volume_objective ? metrics.total_communication_volume : metrics.edge_cut;
+                double new_balance = metrics.balance;
                 std::cout << "after cut\t" << new_cut << std::endl;
                 std::cout << "after balance\t" << new_balance << std::endl;
                 std::cout << "improvement\t" << improvement << std::endl;
@@ -1,5 +1,8 @@
+#pragma once
+
 #include "data_structure/graph_hierarchy.h"
 #include "partition/partition_config.h"
+#include "uncoarsening/refinement/label_propagation_refinement/label_propagation_refinement.h"
 #include "uncoarsening/refinement/parallel_kway_graph_refinement/fast_boundary.h"
 
 namespace parallel {
@@ -7,10 +10,25 @@ namespace parallel {
 class uncoarsening {
 public:
         int perform_uncoarsening_cut(const PartitionConfig& config, graph_hierarchy& hierarchy);
+
+        // projects the separator of the coarsest graph and refines it with label propagation on every level
+        int perform_uncoarsening_nodeseparator(const PartitionConfig& config, graph_hierarchy& hierarchy);
+
+        // number of blocks of a deep multilevel partition on a level with num_nodes nodes
+        static PartitionID deep_multilevel_num_blocks(const PartitionConfig& config, NodeID num_nodes);
+
+        // upper bound of the block weights if the graph is partitioned into k blocks instead of config.k
+        static NodeWeight deep_multilevel_upper_bound(const PartitionConfig& config, PartitionID k);
 private:
+        // bisects all blocks of G in parallel until G has target_k blocks, block b becomes 2b and 2b + 1
+        void split_blocks(const PartitionConfig& config, graph_access& G, PartitionID target_k);
+
         void perform_label_propagation(PartitionConfig& config, graph_access& G);
 
         EdgeWeight perform_multitry_kway(PartitionConfig& config, graph_access& G, boundary_type& boundary);
+
+        // kept for all levels so that its buffers are allocated once
+        label_propagation_refinement m_label_propagation;
 };
 
 }
\ No newline at end of file
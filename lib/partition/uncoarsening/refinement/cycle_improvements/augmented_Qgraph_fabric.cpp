@@ -21,9 +21,12 @@
  *****************************************************************************/
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
 
 #include "algorithms/cycle_search.h"
 #include "augmented_Qgraph_fabric.h"
+#include "data_structure/parallel/thread_pool.h"
 #include "data_structure/priority_queues/bucket_pq.h"
 #include "partition_snapshooter.h"
 #include "quality_metrics.h"
@@ -248,11 +251,160 @@ bool augmented_Qgraph_fabric::build_augmented_quotient_graph( PartitionConfig &
         return false;
 }
 
+void augmented_Qgraph_fabric::parallel_build_augmented_quotient_graph( PartitionConfig & config, 
+                                                                       graph_access & G, 
+                                                                       complete_boundary & boundary, 
+                                                                       augmented_Qgraph & aqg, 
+                                                                       unsigned & s, bool plus) {
+
+        graph_access G_bar;
+        boundary.getUnderlyingQuotientGraph(G_bar); 
+        if(m_eligible.size() != G.number_of_nodes()) {
+                m_eligible.resize(G.number_of_nodes());
+                forall_nodes(G, node) {
+                        m_eligible[node] = true;
+                } endfor
+        } else {
+                cleanup_eligible();
+        }
+
+        std::vector<block_pair_difference> vec_bpd;
+        forall_nodes(G_bar, lhs) {
+                forall_out_edges(G_bar, e, lhs) {
+                        block_pair_difference bpd;
+                        bpd.lhs = lhs;
+                        bpd.rhs = G_bar.getEdgeTarget(e);
+                        vec_bpd.push_back(bpd);
+                } endfor 
+        } endfor
+
+        // the searches undo their moves, so the private copies of the partition stay equal to the one of G
+        struct thread_data {
+                graph_access graph;
+                std::unique_ptr<complete_boundary> boundary;
+                augmented_Qgraph_fabric fabric;
+                size_t synced_ineligible;
+        };
+        std::vector<thread_data> threads(parallel::current_thread_pool().NumThreads() + 1);
+        parallel::submit_for_all([&](uint32_t thread_id) {
+                thread_data & data = threads[thread_id];
+                G.share_topology(data.graph);
+                data.graph.set_partition_count(G.get_partition_count());
+                forall_nodes(G, node) {
+                        data.graph.setPartitionIndex(node, G.getPartitionIndex(node));
+                } endfor
+                data.boundary.reset(new complete_boundary(&data.graph));
+                data.boundary->build();
+                data.fabric.m_eligible.assign(G.number_of_nodes(), true);
+                data.synced_ineligible = 0;
+        });
+
+        for( unsigned j = 0; j < config.kaba_packing_iterations; j++) {
+                random_functions::permutate_vector_good_small(vec_bpd);
+
+                // greedily group the pairs into rounds in which every block is part of at most one pair
+                std::vector< std::vector<boundary_pair> > rounds;
+                std::vector< std::vector<bool> > variants;
+                std::vector< std::vector<bool> > round_blocks;
+                for( unsigned i = 0; i < vec_bpd.size(); i++) {
+                        unsigned r = 0;
+                        while( r < rounds.size() && (round_blocks[r][vec_bpd[i].lhs] || round_blocks[r][vec_bpd[i].rhs]) ) {
+                                r++;
+                        }
+                        if( r == rounds.size() ) {
+                                rounds.emplace_back();
+                                variants.emplace_back();
+                                round_blocks.emplace_back(config.k, false);
+                        }
+
+                        boundary_pair bp;
+                        bp.k   = config.k;
+                        bp.lhs = vec_bpd[i].lhs;
+                        bp.rhs = vec_bpd[i].rhs;
+                        rounds[r].push_back(bp);
+
+                        //best of both worlds
+                        variants[r].push_back(plus && config.kaba_flip_packings ? random_functions::nextBool() : plus);
+
+                        round_blocks[r][bp.lhs] = true;
+                        round_blocks[r][bp.rhs] = true;
+                }
+
+                for( unsigned r = 0; r < rounds.size(); r++) {
+                        std::vector<pairwise_local_search> searches(rounds[r].size());
+                        std::vector<uint8_t> successful(rounds[r].size(), false);
+                        std::atomic<size_t> next(0);
+                        parallel::submit_for_all([&](uint32_t thread_id) {
+                                thread_data & data = threads[thread_id];
+                                size_t i;
+                                while( (i = next.fetch_add(1, std::memory_order_relaxed)) < rounds[r].size() ) {
+                                        successful[i] = data.fabric.search_qgraph_edge(config, data.graph, *data.boundary,
+                                                                                       rounds[r][i], s, variants[r][i],
+                                                                                       searches[i]);
+                                }
+                        });
+
+                        // committing in the order of the round keeps the result independent of the scheduling
+                        for( unsigned i = 0; i < rounds[r].size(); i++) {
+                                if( !successful[i] ) continue;
+
+                                aqg.commit_pairwise_local_search(rounds[r][i], searches[i]);
+                                if( variants[r][i] ) {
+                                        boundary_pair opp_pair = rounds[r][i];
+                                        std::swap(opp_pair.lhs, opp_pair.rhs);
+                                        aqg.commit_pairwise_local_search(opp_pair, searches[i]);
+                                }
+                        }
+
+                        // nodes that a search moved or blocked are not eligible for the following rounds
+                        std::vector<NodeID> ineligible;
+                        for( thread_data & data : threads ) {
+                                std::vector<NodeID> & tomake_eligible = data.fabric.m_tomake_eligible;
+                                ineligible.insert(ineligible.end(), tomake_eligible.begin() + data.synced_ineligible, tomake_eligible.end());
+                        }
+                        for( NodeID node : ineligible ) {
+                                if(m_eligible[node]) m_tomake_eligible.push_back(node);
+                                m_eligible[node] = false;
+                        }
+                        parallel::submit_for_all([&](uint32_t thread_id) {
+                                augmented_Qgraph_fabric & fabric = threads[thread_id].fabric;
+                                for( NodeID node : ineligible ) {
+                                        if(fabric.m_eligible[node]) fabric.m_tomake_eligible.push_back(node);
+                                        fabric.m_eligible[node] = false;
+                                }
+                                threads[thread_id].synced_ineligible = fabric.m_tomake_eligible.size();
+                        });
+                }
+        }
+}
+
 bool augmented_Qgraph_fabric::construct_local_searches_on_qgraph_edge( PartitionConfig & config, graph_access & G, 
                                                                        complete_boundary & boundary, augmented_Qgraph & aqg, 
                                                                        boundary_pair & pair, 
                                                                        unsigned s,
                                                                        bool plus) {
+        pairwise_local_search pls;
+        if(!search_qgraph_edge(config, G, boundary, pair, s, plus, pls)) {
+                return false;
+        }
+
+        aqg.commit_pairwise_local_search(pair, pls);
+
+        if( plus ) {
+                // keep things simple
+                boundary_pair opp_pair = pair;
+                std::swap(opp_pair.lhs, opp_pair.rhs);
+                aqg.commit_pairwise_local_search(opp_pair, pls);
+        }
+        return true;
+}
+
+bool augmented_Qgraph_fabric::search_qgraph_edge( PartitionConfig & config, graph_access & G, 
+                                                  complete_boundary & boundary, 
+                                                  boundary_pair & pair, 
+                                                  unsigned s,
+                                                  bool plus,
+                                                  pairwise_local_search & pls) {
         PartitionID lhs = pair.lhs;
         PartitionID rhs = pair.rhs;
 
@@ -271,31 +423,16 @@ bool augmented_Qgraph_fabric::construct_local_searches_on_qgraph_edge( Partition
         }
 
         commons = kway_graph_refinement_commons::getInstance(config);
-        for( unsigned i = 0; i < 1; i++) {
-
-                if(lhs_boundary.size() == 0) return false;
-
-                pairwise_local_search pls;
-
-                NodeID start_node = lhs_boundary[0];
-                find_eligible_start_node( G, lhs, rhs,  lhs_boundary, m_eligible, start_node);
-                
-                if(!m_eligible[start_node]) return false; // in this case the lhs_boundary was empty and we cant move a node
 
-                if(plus) {
-                        more_locallized_search(config, G,  boundary, lhs, rhs, start_node, s, pls);
-                } else {
-                        directed_more_locallized_search(config, G,  boundary, lhs, rhs, start_node, s, pls);
-                }
-
-                aqg.commit_pairwise_local_search(pair, pls);
+        NodeID start_node = lhs_boundary[0];
+        find_eligible_start_node( G, lhs, rhs,  lhs_boundary, m_eligible, start_node);
+        
+        if(!m_eligible[start_node]) return false; // in this case the lhs_boundary was empty and we cant move a node
 
-                if( plus ) {
-                        // keep things simple
-                        boundary_pair opp_pair = pair;
-                        std::swap(opp_pair.lhs, opp_pair.rhs);
-                        aqg.commit_pairwise_local_search(opp_pair, pls);
-                }
+        if(plus) {
+                more_locallized_search(config, G,  boundary, lhs, rhs, start_node, s, pls);
+        } else {
+                directed_more_locallized_search(config, G,  boundary, lhs, rhs, start_node, s, pls);
         }
         return true;
 }
@@ -45,6 +45,14 @@ class augmented_Qgraph_fabric {
                                                      augmented_Qgraph & aqg,
                                                      unsigned & s, bool rebalance, bool plus = false);
 
+                //same as build_augmented_quotient_graph without rebalancing. The searches of block pairs that
+                //share no block are independent, so these pairs are searched concurrently by the thread pool
+                void parallel_build_augmented_quotient_graph( PartitionConfig & config, 
+                                                              graph_access & G, 
+                                                              complete_boundary & boundary, 
+                                                              augmented_Qgraph & aqg,
+                                                              unsigned & s, bool plus = false);
+
                 void cleanup_eligible();
 
         private:
@@ -56,6 +64,15 @@ class augmented_Qgraph_fabric {
                                                               unsigned s,
                                                               bool plus);
 
+                //performs and undos the local search of a pair, returns false if there was no eligible start node
+                bool search_qgraph_edge( PartitionConfig & config, 
+                                         graph_access & G, 
+                                         complete_boundary & boundary,
+                                         boundary_pair & pair,
+                                         unsigned s,
+                                         bool plus, 
+                                         pairwise_local_search & pls);
+
                 bool local_search(PartitionConfig & config, 
                                   bool  plus,
                                   graph_access & G, 
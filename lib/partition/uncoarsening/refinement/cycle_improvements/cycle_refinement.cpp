@@ -78,7 +78,11 @@ EdgeWeight cycle_refinement::greedy_ultra_model(PartitionConfig & partition_conf
 
         do {
                 augmented_Qgraph aqg;
-                augmented_fabric.build_augmented_quotient_graph(partition_config, G, boundary, aqg, s, false);
+                if( partition_config.parallel_cycle_refinement ) {
+                        augmented_fabric.parallel_build_augmented_quotient_graph(partition_config, G, boundary, aqg, s);
+                } else {
+                        augmented_fabric.build_augmented_quotient_graph(partition_config, G, boundary, aqg, s, false);
+                }
                 something_changed = m_advanced_modelling.compute_vertex_movements_ultra_model(partition_config, 
                                                                                               G,
                                                                                               boundary, 
@@ -153,7 +157,11 @@ EdgeWeight cycle_refinement::greedy_ultra_model_plus(PartitionConfig & partition
         int unsucc_count = 0;
         do {
                 augmented_Qgraph aqg;
-                augmented_fabric.build_augmented_quotient_graph(partition_config, G, boundary, aqg, s, false, true);
+                if( partition_config.parallel_cycle_refinement ) {
+                        augmented_fabric.parallel_build_augmented_quotient_graph(partition_config, G, boundary, aqg, s, true);
+                } else {
+                        augmented_fabric.build_augmented_quotient_graph(partition_config, G, boundary, aqg, s, false, true);
+                }
                 something_changed = m_advanced_modelling.compute_vertex_movements_ultra_model(partition_config, 
                                                                                               G, 
                                                                                               boundary, 
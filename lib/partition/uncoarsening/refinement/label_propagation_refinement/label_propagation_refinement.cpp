@@ -20,6 +20,9 @@
  * this program.  If not, see <http://www.gnu.org/licenses/>.
  *****************************************************************************/
 
+#include "data_structure/parallel/atomic_bitmap.h"
+#include "data_structure/parallel/block_connectivity.h"
+#include "data_structure/parallel/block_weight_reservations.h"
 #include "data_structure/parallel/thread_pool.h"
 #include "data_structure/parallel/time.h"
 #include "label_propagation_refinement.h"
@@ -333,9 +336,9 @@ void label_propagation_refinement::par_init_for_edge_unit(graph_access& G, const
         };
 
         std::vector<std::future<std::vector<NodeWeight>>> futures;
-        futures.reserve(parallel::g_thread_pool.NumThreads());
-        for (size_t i = 0; i < parallel::g_thread_pool.NumThreads(); ++i) {
-                futures.emplace_back(parallel::g_thread_pool.Submit(i, task));
+        futures.reserve(parallel::current_thread_pool().NumThreads());
+        for (size_t i = 0; i < parallel::current_thread_pool().NumThreads(); ++i) {
+                futures.emplace_back(parallel::current_thread_pool().Submit(i, task));
         }
 
         auto cur_cluster_sizes = task();
@@ -428,15 +431,18 @@ EdgeWeight label_propagation_refinement::parallel_label_propagation_with_queue(g
         CLOCK_END("Uncoarsening: Parallel lp: Init queue lp");
 
         std::vector<std::future<NodeWeight>> futures;
-        futures.reserve(parallel::g_thread_pool.NumThreads());
+        futures.reserve(parallel::current_thread_pool().NumThreads());
         NodeWeight num_changed_label = 0;
+        auto reservations = create_reservations(config, cluster_sizes);
 
         CLOCK_START_N;
         std::cout << "Uncoarsening: Num blocks\t" << queue->unsafe_size() << std::endl;
+        int num_rounds = 0;
         for (int j = 0; j < config.label_iterations_refinement; j++) {
-                if (queue->empty()) {
+                if (queue->empty() || parallel::deadline_reached(config.deadline)) {
                         break;
                 }
+                ++num_rounds;
                 auto process = [&](const size_t id) {
                         NodeWeight num_changed_label = 0;
                         Block cur_block;
@@ -465,84 +471,96 @@ EdgeWeight label_propagation_refinement::parallel_label_propagation_with_queue(g
                                                 hash_map[part] += G.getEdgeWeight(e);
                                         } endfor
 
-                                        //second sweep for finding max and resetting array
                                         PartitionID my_block = G.getPartitionIndex(node);
                                         PartitionID max_block = my_block;
-                                        NodeWeight max_cluster_size = 0;
-                                        PartitionID max_value = 0;
-
-                                        for (auto cur_part : neighbor_parts) {
-                                                PartitionID cur_value = hash_map[cur_part];
-                                                NodeWeight cur_cluster_size = cluster_sizes[cur_part].get().load(
-                                                        std::memory_order_acquire);
+                                        bool perform_move = false;
+                                        if (reservations) {
+                                                // the reserved weight already admits the vertex to max_block
+                                                max_block = reserve_best_block(G, node, id, hash_map, neighbor_parts,
+                                                                               *reservations, rnd);
+                                                perform_move = my_block != max_block;
+                                        } else {
+                                                //second sweep for finding max and resetting array
+                                                NodeWeight max_cluster_size = 0;
+                                                PartitionID max_value = 0;
+                                                for (auto cur_part : neighbor_parts) {
+                                                        PartitionID cur_value = hash_map[cur_part];
+                                                        NodeWeight cur_cluster_size = cluster_sizes[cur_part].get().load(
+                                                                std::memory_order_acquire);
+
+                                                        if ((cur_value > max_value || (cur_value == max_value && rnd.bit()))
+                                                            &&
+                                                            (cur_cluster_size + G.getNodeWeight(node) < block_upperbound
+                                                             || (cur_part == my_block &&
+                                                                 cur_cluster_size <= block_upperbound))) {
+                                                                max_value = cur_value;
+                                                                max_block = cur_part;
+                                                                max_cluster_size = cur_cluster_size;
+                                                        }
 
-                                                if ((cur_value > max_value || (cur_value == max_value && rnd.bit()))
-                                                    &&
-                                                    (cur_cluster_size + G.getNodeWeight(node) < block_upperbound
-                                                     || (cur_part == my_block &&
-                                                         cur_cluster_size <= block_upperbound))) {
-                                                        max_value = cur_value;
-                                                        max_block = cur_part;
-                                                        max_cluster_size = cur_cluster_size;
+                                                        hash_map[cur_part] = 0;
                                                 }
-
-                                                hash_map[cur_part] = 0;
-                                        }
-                                        neighbor_parts.clear();
-
-
-                                        bool changed_label = my_block != max_block;
-                                        if (changed_label) {
-                                                // try update size of the cluster
-                                                bool perform_move = true;
-                                                auto& atomic_val = cluster_sizes[max_block].get();
-                                                while (!atomic_val.compare_exchange_weak(
-                                                        max_cluster_size,
-                                                        max_cluster_size + G.getNodeWeight(node),
-                                                        std::memory_order_relaxed)) {
-                                                        if (max_cluster_size + G.getNodeWeight(node) > block_upperbound) {
-                                                                perform_move = false;
-                                                                break;
+                                                neighbor_parts.clear();
+
+                                                if (my_block != max_block) {
+                                                        // try update size of the cluster
+                                                        perform_move = true;
+                                                        auto& atomic_val = cluster_sizes[max_block].get();
+                                                        while (!atomic_val.compare_exchange_weak(
+                                                                max_cluster_size,
+                                                                max_cluster_size + G.getNodeWeight(node),
+                                                                std::memory_order_relaxed)) {
+                                                                if (max_cluster_size + G.getNodeWeight(node) > block_upperbound) {
+                                                                        perform_move = false;
+                                                                        break;
+                                                                }
                                                         }
                                                 }
+                                        }
 
-                                                if (perform_move) {
+                                        if (perform_move) {
+                                                if (reservations) {
+                                                        reservations->release(id, my_block, G.getNodeWeight(node));
+                                                } else {
                                                         cluster_sizes[G.getPartitionIndex(node)].get().fetch_sub(
                                                                 G.getNodeWeight(node), std::memory_order_relaxed);
+                                                }
 
-                                                        G.setPartitionIndex(node, max_block);
-
-                                                        ++num_changed_label;
+                                                G.setPartitionIndex(node, max_block);
 
-                                                        forall_out_edges(G, e, node) {
-                                                                NodeID target = G.getEdgeTarget(e);
-                                                                if (!next_queue_contains[target].exchange(
-                                                                        true, std::memory_order_relaxed)) {
-                                                                        new_block.push_back(target);
+                                                ++num_changed_label;
 
-                                                                        new_block_size += use_edge_unit ? G.getNodeDegree(target) : 1;
-                                                                        if (new_block_size >= max_block_size) {
-                                                                                next_queue->push(std::move(new_block));
-                                                                                new_block.clear();
-                                                                                new_block.reserve(100);
-                                                                                new_block_size = 0;
-                                                                        }
+                                                forall_out_edges(G, e, node) {
+                                                        NodeID target = G.getEdgeTarget(e);
+                                                        if (!next_queue_contains[target].exchange(
+                                                                true, std::memory_order_relaxed)) {
+                                                                new_block.push_back(target);
+
+                                                                new_block_size += use_edge_unit ? G.getNodeDegree(target) : 1;
+                                                                if (new_block_size >= max_block_size) {
+                                                                        next_queue->push(std::move(new_block));
+                                                                        new_block.clear();
+                                                                        new_block.reserve(100);
+                                                                        new_block_size = 0;
                                                                 }
-                                                        } endfor
-                                                }
+                                                        }
+                                                } endfor
                                         }
                                 }
                         }
                         if (!new_block.empty()) {
                                 next_queue->push(std::move(new_block));
                         }
+                        if (reservations) {
+                                reservations->flush(id);
+                        }
                         return num_changed_label;
                 };
 
 
-                for (size_t i = 0; i < parallel::g_thread_pool.NumThreads(); ++i) {
-                        futures.push_back(parallel::g_thread_pool.Submit(i, process, i + 1));
-                        //futures.push_back(parallel::g_thread_pool.Submit(process, i + 1));
+                for (size_t i = 0; i < parallel::current_thread_pool().NumThreads(); ++i) {
+                        futures.push_back(parallel::current_thread_pool().Submit(i, process, i + 1));
+                        //futures.push_back(parallel::current_thread_pool().Submit(process, i + 1));
                 }
 
                 //CLOCK_START;
@@ -556,6 +574,380 @@ EdgeWeight label_propagation_refinement::parallel_label_propagation_with_queue(g
                 futures.clear();
         }
         CLOCK_END("Uncoarsening: Parallel lp: iterations");
+        std::cout << "Uncoarsening: Parallel lp: rounds\t" << num_rounds << std::endl;
+
+        return num_changed_label;
+}
+
+EdgeWeight label_propagation_refinement::parallel_label_propagation_volume(graph_access& G,
+                                                                           PartitionConfig& config,
+                                                                           Cvector<AtomicWrapper<NodeWeight>>& cluster_sizes,
+                                                                           const parallel::ParallelVector<Pair>& permutation) {
+        const NodeWeight block_upperbound = config.upper_bound_partition;
+        const uint32_t num_threads = parallel::current_thread_pool().NumThreads() + 1;
+
+        std::vector<parallel::block_connectivity> connectivities(num_threads, parallel::block_connectivity(config.k));
+        std::vector<parallel::random> rnds;
+        rnds.reserve(num_threads);
+        for (uint32_t id = 0; id < num_threads; ++id) {
+                rnds.emplace_back(config.seed + id);
+        }
+
+        for (PartitionID block = 0; block < config.k; ++block) {
+                cluster_sizes[block].get().store(0, std::memory_order_relaxed);
+        }
+        parallel::parallel_for_index(NodeID(0), G.number_of_nodes(), [&](NodeID node) {
+                cluster_sizes[G.getPartitionIndex(node)].get().fetch_add(G.getNodeWeight(node),
+                                                                        std::memory_order_relaxed);
+        });
+
+        EdgeWeight total_gain = 0;
+        for (int j = 0; j < config.label_iterations_refinement; j++) {
+                if (parallel::deadline_reached(config.deadline)) {
+                        break;
+                }
+
+                std::vector<EdgeWeight> thread_gains(num_threads, 0);
+                parallel::parallel_for_index(NodeID(0), G.number_of_nodes(), [&](NodeID index, uint32_t id) {
+                        NodeID node = permutation[index].first;
+                        PartitionID my_block = G.getPartitionIndex(node);
+                        NodeWeight node_weight = G.getNodeWeight(node);
+
+                        auto& connectivity = connectivities[id];
+                        connectivity.compute_gains(G, node, my_block, [&](NodeID target) {
+                                return G.getPartitionIndex(target);
+                        });
+
+                        const auto& candidates = connectivity.candidates();
+                        size_t best = candidates.size();
+                        Gain best_gain = 0;
+                        for (size_t i = 0; i < candidates.size(); ++i) {
+                                Gain cur_gain = connectivity.gain(i);
+                                if (cur_gain > best_gain || (best < candidates.size() && cur_gain == best_gain
+                                                             && rnds[id].bit())) {
+                                        best = i;
+                                        best_gain = cur_gain;
+                                }
+                        }
+
+                        // only moves that reduce the volume are done, other blocks are not tried
+                        if (best == candidates.size()) {
+                                return;
+                        }
+
+                        PartitionID best_block = candidates[best];
+                        auto& best_size = cluster_sizes[best_block].get();
+                        NodeWeight cur_size = best_size.load(std::memory_order_relaxed);
+                        do {
+                                if (cur_size + node_weight > block_upperbound) {
+                                        return;
+                                }
+                        } while (!best_size.compare_exchange_weak(cur_size, cur_size + node_weight,
+                                                                  std::memory_order_acq_rel));
+
+                        cluster_sizes[my_block].get().fetch_sub(node_weight, std::memory_order_acq_rel);
+                        G.setPartitionIndex(node, best_block);
+                        thread_gains[id] += best_gain;
+                });
+
+                EdgeWeight round_gain = 0;
+                for (auto gain : thread_gains) {
+                        round_gain += gain;
+                }
+                total_gain += round_gain;
+
+                if (round_gain == 0) {
+                        break;
+                }
+        }
+        return total_gain;
+}
+
+block_weight_reservations*
+label_propagation_refinement::create_reservations(const PartitionConfig& config,
+                                                  Cvector<AtomicWrapper<NodeWeight>>& cluster_sizes) {
+        if (!config.lp_block_weight_reservations) {
+                return nullptr;
+        }
+
+        uint32_t num_threads = parallel::current_thread_pool().NumThreads() + 1;
+        NodeWeight batch_size = config.upper_bound_partition / (config.lp_reservation_batch_divisor * num_threads);
+        if (m_reservations && m_reservations->fits(cluster_sizes.size(), num_threads)) {
+                m_reservations->reset(cluster_sizes, config.upper_bound_partition, batch_size);
+        } else {
+                m_reservations = std::make_unique<block_weight_reservations>(cluster_sizes,
+                                                                             config.upper_bound_partition,
+                                                                             num_threads, batch_size);
+        }
+        return m_reservations.get();
+}
+
+PartitionID label_propagation_refinement::reserve_best_block(graph_access& G, NodeID node, uint32_t id,
+                                                             std::vector<PartitionID>& hash_map,
+                                                             std::vector<NodeID>& neighbor_parts,
+                                                             block_weight_reservations& reservations,
+                                                             parallel::random& rnd) const {
+        PartitionID my_block = G.getPartitionIndex(node);
+        PartitionID my_value = hash_map[my_block];
+        PartitionID res = my_block;
+
+        for (uint32_t attempt = 0; attempt < max_admission_attempts; ++attempt) {
+                size_t best = neighbor_parts.size();
+                PartitionID best_value = 0;
+                for (size_t i = 0; i < neighbor_parts.size(); ++i) {
+                        PartitionID cur_part = neighbor_parts[i];
+                        PartitionID cur_value = hash_map[cur_part];
+                        if (cur_part != my_block
+                            && (best == neighbor_parts.size() || cur_value > best_value
+                                || (cur_value == best_value && rnd.bit()))) {
+                                best = i;
+                                best_value = cur_value;
+                        }
+                }
+
+                if (best == neighbor_parts.size() || best_value < my_value
+                    || (best_value == my_value && rnd.bit())) {
+                        break;
+                }
+
+                PartitionID best_part = neighbor_parts[best];
+                if (reservations.reserve(id, best_part, G.getNodeWeight(node))) {
+                        res = best_part;
+                        break;
+                }
+
+                // the block is full, retry with the next best block
+                hash_map[best_part] = 0;
+                neighbor_parts[best] = neighbor_parts.back();
+                neighbor_parts.pop_back();
+        }
+
+        for (auto cur_part : neighbor_parts) {
+                hash_map[cur_part] = 0;
+        }
+        neighbor_parts.clear();
+        return res;
+}
+
+EdgeWeight label_propagation_refinement::parallel_label_propagation_async(graph_access& G,
+                                                                          PartitionConfig& config,
+                                                                          Cvector<AtomicWrapper<NodeWeight>>& cluster_sizes,
+                                                                          std::vector<std::vector<PartitionID>>& hash_maps,
+                                                                          const parallel::ParallelVector<Pair>& permutation) {
+        CLOCK_START;
+        const NodeWeight block_upperbound = config.upper_bound_partition;
+        const uint32_t num_threads = parallel::current_thread_pool().NumThreads() + 1;
+        auto initial_queue = std::make_unique<ConcurrentQueue>();
+        Cvector<ConcurrentQueue> queues(num_threads);
+
+        uint32_t max_block_size = get_block_size(G, config);
+        std::cout << "Uncoarsening: Block size\t" << max_block_size << std::endl;
+
+        bool use_edge_unit = config.block_size_unit == BlockSizeUnit::EDGES;
+        if (use_edge_unit) {
+                if (G.number_of_nodes() < 100) {
+                        seq_init_for_edge_unit(G, max_block_size, permutation, cluster_sizes, initial_queue);
+                } else {
+                        par_init_for_edge_unit(G, max_block_size, permutation, cluster_sizes, initial_queue);
+                }
+        } else {
+                init_for_node_unit(G, max_block_size, permutation, cluster_sizes, initial_queue);
+        }
+
+        // a bit is set iff the vertex is contained in one of the queues, initially all vertices are active
+        atomic_bitmap active(G.number_of_nodes());
+        parallel::submit_for_all([&](uint32_t thread_id) {
+                size_t words_per_thread = (active.num_words() + num_threads - 1) / num_threads;
+                size_t begin = std::min(thread_id * words_per_thread, active.num_words());
+                size_t end = std::min(begin + words_per_thread, active.num_words());
+                for (size_t word = begin; word < end; ++word) {
+                        size_t bits = std::min<size_t>(G.number_of_nodes() - word * atomic_bitmap::bits_per_word,
+                                                       atomic_bitmap::bits_per_word);
+                        active.store_word(word, bits == atomic_bitmap::bits_per_word
+                                                ? ~atomic_bitmap::word_type(0)
+                                                : (atomic_bitmap::word_type(1) << bits) - 1);
+                }
+        });
+        CLOCK_END("Uncoarsening: Parallel lp: Init queue lp");
+
+        // number of blocks which are queued, processed or being filled by a thread.
+        // Once it drops to zero no vertex is active and it can not increase anymore.
+        std::atomic<uint64_t> pending_blocks(initial_queue->unsafe_size());
+        // the number of vertex visits is bounded by the work of label_iterations_refinement rounds
+        const uint64_t max_visits = (uint64_t) config.label_iterations_refinement * G.number_of_nodes();
+        std::atomic<uint64_t> num_visits(0);
+        std::atomic<bool> stop(false);
+        auto reservations = create_reservations(config, cluster_sizes);
+
+        CLOCK_START_N;
+        std::cout << "Uncoarsening: Num blocks\t" << pending_blocks.load() << std::endl;
+        auto process = [&](uint32_t id) {
+                NodeWeight num_changed_label = 0;
+                Block cur_block;
+                Block new_block;
+                size_t new_block_size = 0;
+                new_block.reserve(100);
+
+                parallel::random rnd(config.seed + id);
+                auto& hash_map = hash_maps[id];
+                auto& own_queue = queues[id].get();
+                std::vector<NodeID> neighbor_parts;
+
+                auto push_new_block = [&]() {
+                        own_queue.push(std::move(new_block));
+                        new_block.clear();
+                        new_block.reserve(100);
+                        new_block_size = 0;
+                };
+
+                auto pop_block = [&]() {
+                        if (own_queue.try_pop(cur_block) || initial_queue->try_pop(cur_block)) {
+                                return true;
+                        }
+                        for (uint32_t i = 1; i < num_threads; ++i) {
+                                if (queues[(id + i) % num_threads].get().try_pop(cur_block)) {
+                                        return true;
+                                }
+                        }
+                        return false;
+                };
+
+                while (!stop.load(std::memory_order_relaxed)) {
+                        if (!pop_block()) {
+                                if (!new_block.empty()) {
+                                        // share the partially filled block instead of waiting
+                                        push_new_block();
+                                        continue;
+                                }
+                                if (pending_blocks.load(std::memory_order_acquire) == 0) {
+                                        break;
+                                }
+                                std::this_thread::yield();
+                                continue;
+                        }
+
+                        if (num_visits.fetch_add(cur_block.size(), std::memory_order_relaxed) + cur_block.size() > max_visits
+                            || parallel::deadline_reached(config.deadline)) {
+                                stop.store(true, std::memory_order_relaxed);
+                        }
+
+                        for (auto node : cur_block) {
+                                active.reset(node);
+
+                                //now move the node to the cluster that is most common in the neighborhood
+                                neighbor_parts.clear();
+                                neighbor_parts.reserve(G.getNodeDegree(node));
+                                forall_out_edges(G, e, node) {
+                                        NodeID target = G.getEdgeTarget(e);
+                                        PartitionID part = G.getPartitionIndex(target);
+                                        if (hash_map[part] == 0) {
+                                                neighbor_parts.push_back(part);
+                                        }
+                                        hash_map[part] += G.getEdgeWeight(e);
+                                } endfor
+
+                                PartitionID my_block = G.getPartitionIndex(node);
+                                PartitionID max_block = my_block;
+                                if (reservations) {
+                                        // the reserved weight already admits the vertex to max_block
+                                        max_block = reserve_best_block(G, node, id, hash_map, neighbor_parts,
+                                                                       *reservations, rnd);
+                                        if (my_block == max_block) {
+                                                continue;
+                                        }
+                                } else {
+                                        //second sweep for finding max and resetting array
+                                        NodeWeight max_cluster_size = 0;
+                                        PartitionID max_value = 0;
+                                        for (auto cur_part : neighbor_parts) {
+                                                PartitionID cur_value = hash_map[cur_part];
+                                                NodeWeight cur_cluster_size = cluster_sizes[cur_part].get().load(
+                                                        std::memory_order_acquire);
+
+                                                if ((cur_value > max_value || (cur_value == max_value && rnd.bit()))
+                                                    &&
+                                                    (cur_cluster_size + G.getNodeWeight(node) < block_upperbound
+                                                     || (cur_part == my_block &&
+                                                         cur_cluster_size <= block_upperbound))) {
+                                                        max_value = cur_value;
+                                                        max_block = cur_part;
+                                                        max_cluster_size = cur_cluster_size;
+                                                }
+
+                                                hash_map[cur_part] = 0;
+                                        }
+                                        neighbor_parts.clear();
+
+                                        if (my_block == max_block) {
+                                                continue;
+                                        }
+
+                                        // try update size of the cluster
+                                        bool perform_move = true;
+                                        auto& atomic_val = cluster_sizes[max_block].get();
+                                        while (!atomic_val.compare_exchange_weak(
+                                                max_cluster_size,
+                                                max_cluster_size + G.getNodeWeight(node),
+                                                std::memory_order_relaxed)) {
+                                                if (max_cluster_size + G.getNodeWeight(node) > block_upperbound) {
+                                                        perform_move = false;
+                                                        break;
+                                                }
+                                        }
+
+                                        if (!perform_move) {
+                                                continue;
+                                        }
+                                }
+
+                                if (reservations) {
+                                        reservations->release(id, my_block, G.getNodeWeight(node));
+                                } else {
+                                        cluster_sizes[my_block].get().fetch_sub(G.getNodeWeight(node),
+                                                                                std::memory_order_relaxed);
+                                }
+                                G.setPartitionIndex(node, max_block);
+                                ++num_changed_label;
+
+                                forall_out_edges(G, e, node) {
+                                        NodeID target = G.getEdgeTarget(e);
+                                        if (!active.test_and_set(target)) {
+                                                continue;
+                                        }
+
+                                        if (new_block.empty()) {
+                                                pending_blocks.fetch_add(1, std::memory_order_relaxed);
+                                        }
+                                        new_block.push_back(target);
+
+                                        new_block_size += use_edge_unit ? G.getNodeDegree(target) : 1;
+                                        if (new_block_size >= max_block_size) {
+                                                push_new_block();
+                                        }
+                                } endfor
+                        }
+                        pending_blocks.fetch_sub(1, std::memory_order_release);
+                }
+                if (reservations) {
+                        reservations->flush(id);
+                }
+                return num_changed_label;
+        };
+
+        std::vector<std::future<NodeWeight>> futures;
+        futures.reserve(parallel::current_thread_pool().NumThreads());
+        for (size_t i = 0; i < parallel::current_thread_pool().NumThreads(); ++i) {
+                futures.push_back(parallel::current_thread_pool().Submit(i, process, i + 1));
+        }
+
+        NodeWeight num_changed_label = process(0);
+        std::for_each(futures.begin(), futures.end(), [&](auto& future){
+                num_changed_label += future.get();
+        });
+        CLOCK_END("Uncoarsening: Parallel lp: iterations");
+        std::cout << "Uncoarsening: Parallel lp: vertex visits\t" << num_visits.load() << std::endl;
+        std::cout << "Uncoarsening: Parallel lp: rounds\t"
+                  << (G.number_of_nodes() > 0 ? (double) num_visits.load() / G.number_of_nodes() : 0.0) << std::endl;
 
         return num_changed_label;
 }
@@ -567,7 +959,7 @@ EdgeWeight label_propagation_refinement::parallel_label_propagation(graph_access
                                                                     const parallel::ParallelVector<Pair>& permutation) {
         NodeWeight block_upperbound = config.upper_bound_partition;
         std::vector<std::future<NodeWeight>> futures;
-        futures.reserve(parallel::g_thread_pool.NumThreads());
+        futures.reserve(parallel::current_thread_pool().NumThreads());
         NodeWeight num_changed_label = 0;
 
         forall_nodes(G, node) {
@@ -575,6 +967,9 @@ EdgeWeight label_propagation_refinement::parallel_label_propagation(graph_access
         } endfor
 
         for (int j = 0; j < config.label_iterations_refinement; j++) {
+                if (parallel::deadline_reached(config.deadline)) {
+                        break;
+                }
                 auto process = [&](const size_t id, NodeID begin, NodeID end) {
                         auto& hash_map = hash_maps[id];
                         NodeWeight num_changed_label = 0;
@@ -640,12 +1035,12 @@ EdgeWeight label_propagation_refinement::parallel_label_propagation(graph_access
                         return num_changed_label;
                 };
 
-                size_t work_per_thread = G.number_of_nodes() / (parallel::g_thread_pool.NumThreads() + 1);
+                size_t work_per_thread = G.number_of_nodes() / (parallel::current_thread_pool().NumThreads() + 1);
                 NodeID first = 0;
-                for (size_t i = 0; i < parallel::g_thread_pool.NumThreads(); ++i) {
-                        futures.push_back(parallel::g_thread_pool.Submit(i, process, i + 1, first,
+                for (size_t i = 0; i < parallel::current_thread_pool().NumThreads(); ++i) {
+                        futures.push_back(parallel::current_thread_pool().Submit(i, process, i + 1, first,
                                                                          first + work_per_thread));
-//                        futures.push_back(parallel::g_thread_pool.Submit(process, i + 1, first,
+//                        futures.push_back(parallel::current_thread_pool().Submit(process, i + 1, first,
 //                                                                         first + work_per_thread));
 
                         first += work_per_thread;
@@ -684,8 +1079,11 @@ EdgeWeight label_propagation_refinement::parallel_label_propagation_with_queue_w
 
         NodeWeight num_changed_label = 0;
 
-        ALWAYS_ASSERT(!config.graph_allready_partitioned);
-        ALWAYS_ASSERT(!config.combine);
+        // on a partitioned graph clusters must not cross blocks, e.g. in later v-cycles or when an
+        // input partition is improved. clusters start as singletons and only grow by neighbors of
+        // the same block, hence ignoring other blocks is enough
+        const bool respect_partition = config.graph_allready_partitioned;
+        const bool respect_second_partition = config.combine;
 
         using hash_function_type = parallel::MurmurHash<NodeID>;
         using hash_value_type = hash_function_type::hash_type;
@@ -719,6 +1117,12 @@ EdgeWeight label_propagation_refinement::parallel_label_propagation_with_queue_w
                                         neighbor_parts.reserve(G.getNodeDegree(node));
                                         forall_out_edges(G, e, node){
                                                 NodeID target = G.getEdgeTarget(e);
+                                                if ((respect_partition
+                                                     && G.getPartitionIndex(target) != G.getPartitionIndex(node))
+                                                    || (respect_second_partition
+                                                        && G.getSecondPartitionIndex(target) != G.getSecondPartitionIndex(node))) {
+                                                        continue;
+                                                }
                                                 NodeID cluster = cluster_id[target];
                                                 auto& clst_size = hash_map[cluster];
                                                 if (clst_size == 0) {
@@ -864,7 +1268,7 @@ EdgeWeight label_propagation_refinement::parallel_label_propagation_many_cluster
                 CLOCK_END("Generate permutation");
         }
 
-        parallel::g_thread_pool.Clear();
+        parallel::current_thread_pool().Clear();
         parallel::Unpin();
 
         {
@@ -878,7 +1282,7 @@ EdgeWeight label_propagation_refinement::parallel_label_propagation_many_cluster
                 CLOCK_END("Sort");
         }
         parallel::PinToCore(0);
-        parallel::g_thread_pool.Resize(config.num_threads - 1);
+        parallel::current_thread_pool().Resize(config.num_threads - 1);
 
         CLOCK_END("Parallel init of permutations lp");
 
@@ -997,7 +1401,7 @@ EdgeWeight label_propagation_refinement::parallel_label_propagation(PartitionCon
                 CLOCK_END("Generate permutation");
         }
         CLOCK_START_N;
-        parallel::g_thread_pool.Clear();
+        parallel::current_thread_pool().Clear();
         parallel::Unpin();
         {
                 CLOCK_START;
@@ -1009,16 +1413,20 @@ EdgeWeight label_propagation_refinement::parallel_label_propagation(PartitionCon
                 CLOCK_END("Uncoarsening: Sort");
         }
         parallel::PinToCore(0);
-        parallel::g_thread_pool.Resize(config.num_threads - 1);
+        parallel::current_thread_pool().Resize(config.num_threads - 1);
         CLOCK_END("Uncoarsening: Sort with pool release");
 
 
         EdgeWeight res = 0;
         CLOCK_START_N;
-        if (config.parallel_lp_type == ParallelLPType::NO_QUEUE) {
+        if (config.refinement_objective == RefinementObjective::COMMUNICATION_VOLUME) {
+                res = parallel_label_propagation_volume(G, config, cluster_sizes, permutation);
+        } else if (config.parallel_lp_type == ParallelLPType::NO_QUEUE) {
                 res = parallel_label_propagation(G, config, cluster_sizes, hash_maps, permutation);
         } else if (config.parallel_lp_type == ParallelLPType::QUEUE) {
                 res = parallel_label_propagation_with_queue(G, config, cluster_sizes, hash_maps, permutation);
+        } else if (config.parallel_lp_type == ParallelLPType::ASYNC_QUEUE) {
+                res = parallel_label_propagation_async(G, config, cluster_sizes, hash_maps, permutation);
         } else {
                 res = 0;
         }
@@ -1031,7 +1439,7 @@ EdgeWeight label_propagation_refinement::parallel_label_propagation(PartitionCon
 //void label_propagation_refinement::parallel_get_boundary_nodes(PartitionConfig& config, graph_access& G,
 //                                                               std::vector<uint8_t>& boundary_nodes) {
 //        std::vector<std::future<void>> futures;
-//        futures.reserve(parallel::g_thread_pool.NumThreads());
+//        futures.reserve(parallel::current_thread_pool().NumThreads());
 //
 //
 //        uint32_t block_size = (uint32_t) sqrt(G.number_of_nodes());
@@ -1068,8 +1476,8 @@ EdgeWeight label_propagation_refinement::parallel_label_propagation(PartitionCon
 //                }
 //        };
 //
-//        for (size_t i = 0; i < parallel::g_thread_pool.NumThreads(); ++i) {
-//                futures.push_back(parallel::g_thread_pool.Submit(i, process, i + 1));
+//        for (size_t i = 0; i < parallel::current_thread_pool().NumThreads(); ++i) {
+//                futures.push_back(parallel::current_thread_pool().Submit(i, process, i + 1));
 //        }
 //
 //        process(0);
@@ -26,8 +26,10 @@
 
 #include "data_structure/parallel/algorithm.h"
 #include "data_structure/parallel/atomics.h"
+#include "data_structure/parallel/block_weight_reservations.h"
 
 #include "data_structure/parallel/pool_allocator.h"
+#include "data_structure/parallel/random.h"
 #include "data_structure/parallel/thread_pool.h"
 
 #include "definitions.h"
@@ -35,6 +37,7 @@
 
 #include <tbb/concurrent_queue.h>
 
+#include <memory>
 #include <vector>
 
 class label_propagation_refinement : public refinement {
@@ -98,6 +101,39 @@ private:
                                                          std::vector<std::vector<PartitionID>>& hash_maps,
                                                          const parallel::ParallelVector<Pair>& permutation);
 
+        // processes active vertices without rounds: blocks of active vertices are taken from per thread
+        // queues with stealing and the search stops as soon as no vertex is active anymore
+        EdgeWeight parallel_label_propagation_async(graph_access& G,
+                                                    PartitionConfig& config,
+                                                    parallel::Cvector<parallel::AtomicWrapper<NodeWeight>>& cluster_sizes,
+                                                    std::vector<std::vector<PartitionID>>& hash_maps,
+                                                    const parallel::ParallelVector<Pair>& permutation);
+
+        // moves vertices in rounds to the admissible block which reduces the total communication volume the most,
+        // the gains are computed against the shared partition which other threads change concurrently
+        EdgeWeight parallel_label_propagation_volume(graph_access& G,
+                                                     PartitionConfig& config,
+                                                     parallel::Cvector<parallel::AtomicWrapper<NodeWeight>>& cluster_sizes,
+                                                     const parallel::ParallelVector<Pair>& permutation);
+
+        // number of blocks tried for a vertex if the preferred blocks do not admit it
+        static constexpr uint32_t max_admission_attempts = 4;
+
+        // returns nullptr if reservations are disabled. The quotas are kept for later calls and only
+        // allocated again if the number of blocks or threads changes.
+        parallel::block_weight_reservations*
+        create_reservations(const PartitionConfig& config,
+                            parallel::Cvector<parallel::AtomicWrapper<NodeWeight>>& cluster_sizes);
+
+        // reserves the weight of the vertex in the block with the strongest connection that admits it
+        // and returns that block, or the block of the vertex if no better block admits it. The caller
+        // moves the vertex. Resets hash_map and clears neighbor_parts.
+        PartitionID reserve_best_block(graph_access& G, NodeID node, uint32_t id,
+                                       std::vector<PartitionID>& hash_map,
+                                       std::vector<NodeID>& neighbor_parts,
+                                       parallel::block_weight_reservations& reservations,
+                                       parallel::random& rnd) const;
+
         EdgeWeight parallel_label_propagation_with_queue_with_many_clusters(graph_access& G,
                                                                             const PartitionConfig& config,
                                                                             const NodeWeight block_upperbound,
@@ -143,6 +179,8 @@ private:
 
         void parallel_remap_cluster_ids_fast(const PartitionConfig& partition_config, graph_access& G,
                                              std::vector<NodeWeight>& cluster_id, NodeID& no_of_coarse_vertices);
+
+        std::unique_ptr<parallel::block_weight_reservations> m_reservations;
 };
 
 
@@ -0,0 +1,126 @@
+#include "data_structure/parallel/algorithm.h"
+#include "data_structure/parallel/atomics.h"
+#include "data_structure/parallel/thread_pool.h"
+#include "data_structure/parallel/time.h"
+#include "uncoarsening/refinement/node_separators/parallel_lp_ns_local_search.h"
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+namespace parallel {
+
+NodeWeight lp_ns_local_search::perform_refinement(const PartitionConfig& config, graph_access& G) {
+        const PartitionID separator = G.getSeparatorBlock();
+        const uint32_t num_threads = current_thread_pool().NumThreads() + 1;
+
+        // the separator membership of a node is changed with compare and swap
+        std::vector<AtomicWrapper<PartitionID>> blocks(G.number_of_nodes());
+        std::vector<std::array<NodeWeight, 3>> thread_weights(num_threads, {{0, 0, 0}});
+        std::vector<std::vector<NodeID>> thread_separators(num_threads);
+        parallel_for_index(NodeID(0), G.number_of_nodes(), [&](NodeID node, uint32_t thread_id) {
+                PartitionID block = G.getPartitionIndex(node);
+                blocks[node].store(block, std::memory_order_relaxed);
+                thread_weights[thread_id][block] += G.getNodeWeight(node);
+                if (block == separator) {
+                        thread_separators[thread_id].push_back(node);
+                }
+        });
+
+        std::array<AtomicWrapper<NodeWeight>, 3> block_weights;
+        std::vector<NodeID> separator_nodes;
+        for (uint32_t id = 0; id < num_threads; ++id) {
+                for (PartitionID block = 0; block < 3; ++block) {
+                        block_weights[block].fetch_add(thread_weights[id][block], std::memory_order_relaxed);
+                }
+                separator_nodes.insert(separator_nodes.end(), thread_separators[id].begin(),
+                                       thread_separators[id].end());
+                thread_separators[id].clear();
+        }
+        const NodeWeight initial_separator_weight = block_weights[separator].load(std::memory_order_relaxed);
+
+        // the first round moves nodes into the lighter block
+        const PartitionID first_target = block_weights[0].load() <= block_weights[1].load() ? 0 : 1;
+        uint32_t rounds_without_moves = 0;
+        for (uint32_t round = 0; round < config.sep_num_lp_rounds && rounds_without_moves < 2; ++round) {
+                if (separator_nodes.empty() || deadline_reached(config.deadline)) {
+                        break;
+                }
+
+                const PartitionID to = round % 2 == 0 ? first_target : 1 - first_target;
+                const PartitionID other = 1 - to;
+                std::atomic<size_t> num_moves(0);
+
+                parallel_for_index(size_t(0), separator_nodes.size(), [&](size_t index, uint32_t thread_id) {
+                        NodeID node = separator_nodes[index];
+                        NodeWeight node_weight = G.getNodeWeight(node);
+
+                        NodeWeight pulled_weight = 0;
+                        forall_out_edges(G, e, node) {
+                                NodeID target = G.getEdgeTarget(e);
+                                if (blocks[target].load(std::memory_order_relaxed) == other) {
+                                        pulled_weight += G.getNodeWeight(target);
+                                }
+                        } endfor
+
+                        // moves without gain are only done if they improve the balance
+                        if (pulled_weight > node_weight
+                            || (pulled_weight == node_weight
+                                && block_weights[to].load(std::memory_order_relaxed) + node_weight
+                                   >= block_weights[other].load(std::memory_order_relaxed))) {
+                                return;
+                        }
+
+                        NodeWeight to_weight = block_weights[to].load(std::memory_order_relaxed);
+                        do {
+                                if (to_weight + node_weight > config.upper_bound_partition) {
+                                        return;
+                                }
+                        } while (!block_weights[to].compare_exchange_weak(to_weight, to_weight + node_weight,
+                                                                          std::memory_order_acq_rel));
+                        blocks[node].store(to, std::memory_order_relaxed);
+
+                        // neighbors that other moves already pulled into the separator are not counted twice
+                        NodeWeight moved_weight = 0;
+                        forall_out_edges(G, e, node) {
+                                NodeID target = G.getEdgeTarget(e);
+                                PartitionID expected = other;
+                                if (blocks[target].load(std::memory_order_relaxed) == other
+                                    && blocks[target].compare_exchange_strong(expected, separator,
+                                                                              std::memory_order_acq_rel)) {
+                                        moved_weight += G.getNodeWeight(target);
+                                        thread_separators[thread_id].push_back(target);
+                                }
+                        } endfor
+
+                        block_weights[other].fetch_sub(moved_weight, std::memory_order_relaxed);
+                        block_weights[separator].fetch_add(moved_weight, std::memory_order_relaxed);
+                        block_weights[separator].fetch_sub(node_weight, std::memory_order_relaxed);
+                        num_moves.fetch_add(1, std::memory_order_relaxed);
+                });
+
+                rounds_without_moves = num_moves.load() == 0 ? rounds_without_moves + 1 : 0;
+
+                // the separator of the next round consists of the remaining and the pulled nodes
+                std::vector<NodeID> next_separator_nodes;
+                next_separator_nodes.reserve(separator_nodes.size());
+                for (NodeID node : separator_nodes) {
+                        if (blocks[node].load(std::memory_order_relaxed) == separator) {
+                                next_separator_nodes.push_back(node);
+                        }
+                }
+                for (auto& pulled : thread_separators) {
+                        next_separator_nodes.insert(next_separator_nodes.end(), pulled.begin(), pulled.end());
+                        pulled.clear();
+                }
+                separator_nodes.swap(next_separator_nodes);
+        }
+
+        parallel_for_index(NodeID(0), G.number_of_nodes(), [&](NodeID node) {
+                G.setPartitionIndex(node, blocks[node].load(std::memory_order_relaxed));
+        });
+
+        return initial_separator_weight - block_weights[separator].load(std::memory_order_relaxed);
+}
+
+}
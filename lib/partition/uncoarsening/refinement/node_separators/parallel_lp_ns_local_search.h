@@ -0,0 +1,18 @@
+#pragma once
+
+#include "data_structure/graph_access.h"
+#include "partition_config.h"
+
+namespace parallel {
+
+// Label propagation style refinement of a node separator. A round moves separator nodes concurrently into one
+// target block if the separator becomes lighter, their neighbors in the other block enter the separator.
+// Since no node enters the other block during a round, concurrent moves can not create an edge between
+// the two blocks. The target block alternates between rounds.
+class lp_ns_local_search {
+public:
+        // G contains a separator, returns how much lighter the separator became
+        NodeWeight perform_refinement(const PartitionConfig& config, graph_access& G);
+};
+
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "data_structure/graph_access.h"
+#include "data_structure/parallel/atomic_bitmap.h"
 #include "data_structure/parallel/graph_algorithm.h"
 #include "data_structure/parallel/hash_table.h"
 #include "data_structure/parallel/task_queue.h"
@@ -299,9 +300,9 @@ public:
                 };
 
                 std::vector<std::future<NodeID>> futures_other;
-                futures_other.reserve(parallel::g_thread_pool.NumThreads());
-                for (size_t i = 0; i < parallel::g_thread_pool.NumThreads(); ++i) {
-                        futures_other.push_back(parallel::g_thread_pool.Submit(i, task_copy_to_hash_tables, i + 1));
+                futures_other.reserve(parallel::current_thread_pool().NumThreads());
+                for (size_t i = 0; i < parallel::current_thread_pool().NumThreads(); ++i) {
+                        futures_other.push_back(parallel::current_thread_pool().Submit(i, task_copy_to_hash_tables, i + 1));
                 }
                 std::cout << task_copy_to_hash_tables(0) << " ";
 
@@ -383,9 +384,9 @@ public:
                         m_boundaries_per_thread[thread_id].get().reserve(1);
                 };
                 std::vector<std::future<void>> futures;
-                futures.reserve(parallel::g_thread_pool.NumThreads());
-                for (size_t i = 0; i < parallel::g_thread_pool.NumThreads(); ++i) {
-                        futures.push_back(parallel::g_thread_pool.Submit(i, task, i + 1));
+                futures.reserve(parallel::current_thread_pool().NumThreads());
+                for (size_t i = 0; i < parallel::current_thread_pool().NumThreads(); ++i) {
+                        futures.push_back(parallel::current_thread_pool().Submit(i, task, i + 1));
                 }
                 task(0);
 
@@ -591,7 +592,7 @@ public:
         }
 
         void construct_boundary() {
-                if (parallel::g_thread_pool.NumThreads() == 0) {
+                if (parallel::current_thread_pool().NumThreads() == 0) {
                         distribute_boundary_vertices(m_G, [this](uint32_t vertex, uint32_t) {
                                 return external_neighbors(vertex);
                         });
@@ -736,8 +737,208 @@ private:
         }
 };
 
+// Boundary with one atomic flag per vertex. Refinement threads mark vertices whose state may have
+// changed in a second bitmap and only these vertices are rechecked in finish_movements. The boundary
+// of a finer level is projected from the coarser level: a vertex can only be a boundary vertex if
+// its coarse vertex is one, so only these vertices are checked.
+class fast_parallel_boundary_incremental : public fast_boundary {
+public:
+        fast_parallel_boundary_incremental(graph_access& G, const PartitionConfig& config)
+                :       fast_boundary(G, config)
+                ,       m_boundary(G.number_of_nodes())
+                ,       m_to_check(G.number_of_nodes())
+                ,       m_containers(std::max<uint32_t>(m_config.num_threads * m_config.num_threads, 1))
+        {}
+
+        inline bool contains(NodeID vertex) const {
+                return m_boundary.test(vertex);
+        }
+
+        size_t size() const {
+                return m_boundary.count(0, m_boundary.num_words());
+        }
+
+        const atomic_bitmap& get_bitmap() const {
+                return m_boundary;
+        }
+
+        // called only by single threaded executions
+        void move(NodeID vertex, PartitionID from, PartitionID to) {
+                ALWAYS_ASSERT(m_G.getPartitionIndex(vertex) == to);
+
+                bool external_neighbors = false;
+                forall_out_edges(m_G, e, vertex) {
+                        NodeID target = m_G.getEdgeTarget(e);
+                        PartitionID target_block = m_G.getPartitionIndex(target);
+
+                        if (target_block == from) {
+                                m_boundary.set(target);
+                        }
+
+                        if (target_block == to && !has_external_neighbor(target)) {
+                                m_boundary.reset(target);
+                        }
+
+                        if (target_block != to) {
+                                external_neighbors = true;
+                        }
+                } endfor
+
+                if (external_neighbors) {
+                        m_boundary.set(vertex);
+                } else {
+                        m_boundary.reset(vertex);
+                }
+        }
+
+        void construct_boundary() {
+                build([](NodeID) {
+                        return true;
+                });
+        }
+
+        // only boundary vertices of the region become start vertices of the refinement
+        void construct_boundary(const atomic_bitmap& region) {
+                build([&region](NodeID node) {
+                        return region.test(node);
+                });
+        }
+
+        void project(const fast_parallel_boundary_incremental& coarser_boundary, const CoarseMapping& coarse_mapping) {
+                build([&coarser_boundary, &coarse_mapping](NodeID node) {
+                        return coarser_boundary.contains(coarse_mapping[node]);
+                });
+        }
+
+        void check_boundary() {
+                std::vector<NodeID> this_boundary;
+                this_boundary.reserve(size());
+                m_boundary.for_each_set_bit(0, m_boundary.num_words(), [&this_boundary](NodeID node) {
+                        this_boundary.push_back(node);
+                });
+
+                std::vector<NodeID> expected_boundary;
+                expected_boundary.reserve(this_boundary.size());
+                std::cout << "Boundary diff: " << std::endl;
+                forall_nodes(m_G, n) {
+                        bool boundary = has_external_neighbor(n);
+                        if (boundary) {
+                                expected_boundary.push_back(n);
+                                if (!contains(n)) {
+                                        std::cout << "(" << n << ", FN) ";
+                                }
+                        } else if (contains(n)) {
+                                std::cout << "(" << n << ", FP) ";
+                        }
+                } endfor
+                std::cout << std::endl;
+                std::cout << "check size = " << this_boundary.size() << std::endl;
+                if (expected_boundary != this_boundary) {
+                        std::cout << "expected size = " << expected_boundary.size() << std::endl;
+                        std::cout << "this size = " << this_boundary.size() << std::endl;
+                        ALWAYS_ASSERT(expected_boundary == this_boundary);
+                }
+        }
+
+        void begin_movements() {
+        }
+
+        // can be called concurrently, every vertex is stored once until finish_movements
+        void add_vertex_to_check(NodeID vertex) {
+                if (m_to_check.test_and_set(vertex)) {
+                        size_t container_id = (vertex / atomic_bitmap::bits_per_word) % m_containers.size();
+                        m_containers[container_id].get().concurrent_emplace_back(vertex);
+                }
+        }
+
+        void finish_movements() {
+                std::atomic<size_t> offset(0);
+                parallel::submit_for_all([this, &offset](uint32_t) {
+                        size_t container_id = offset.fetch_add(1, std::memory_order_relaxed);
+                        while (container_id < m_containers.size()) {
+                                auto& container = m_containers[container_id].get();
+                                for (NodeID vertex : container) {
+                                        m_to_check.reset(vertex);
+                                        if (has_external_neighbor(vertex)) {
+                                                m_boundary.set(vertex);
+                                        } else {
+                                                m_boundary.reset(vertex);
+                                        }
+                                }
+                                container.clear();
+                                container_id = offset.fetch_add(1, std::memory_order_relaxed);
+                        }
+                });
+        }
+
+private:
+        atomic_bitmap m_boundary;
+        atomic_bitmap m_to_check;
+        Cvector<thread_container<NodeID>> m_containers;
+
+        inline bool has_external_neighbor(NodeID vertex) const {
+                PartitionID cur_part = m_G.getPartitionIndex(vertex);
+                forall_out_edges(m_G, e, vertex) {
+                        if (m_G.getPartitionIndex(m_G.getEdgeTarget(e)) != cur_part) {
+                                return true;
+                        }
+                } endfor
+                return false;
+        }
+
+        // words of the bitmap are distributed among threads, so they can be written without atomics
+        template <typename TFilter>
+        void build(TFilter&& is_candidate) {
+                CLOCK_START;
+                const size_t num_words = m_boundary.num_words();
+                const size_t block_size = std::max<size_t>(sqrt(num_words), 16);
+                const NodeID num_nodes = m_G.number_of_nodes();
+
+                std::atomic<size_t> offset(0);
+                auto task = [&](uint32_t) {
+                        std::vector<block_data_type> blocks_info(m_G.get_partition_count());
+                        size_t begin = offset.fetch_add(block_size, std::memory_order_relaxed);
+                        while (begin < num_words) {
+                                size_t end = std::min(begin + block_size, num_words);
+                                for (size_t word_index = begin; word_index < end; ++word_index) {
+                                        atomic_bitmap::word_type word = 0;
+                                        NodeID first = word_index * atomic_bitmap::bits_per_word;
+                                        NodeID last = std::min<NodeID>(first + atomic_bitmap::bits_per_word, num_nodes);
+                                        for (NodeID node = first; node < last; ++node) {
+                                                PartitionID cur_part = m_G.getPartitionIndex(node);
+                                                ++blocks_info[cur_part].block_size;
+                                                blocks_info[cur_part].block_weight += m_G.getNodeWeight(node);
+
+                                                if (is_candidate(node) && has_external_neighbor(node)) {
+                                                        word |= atomic_bitmap::word_type(1) << (node - first);
+                                                }
+                                        }
+                                        m_boundary.store_word(word_index, word);
+                                }
+                                begin = offset.fetch_add(block_size, std::memory_order_relaxed);
+                        }
+                        return blocks_info;
+                };
+
+                m_blocks_info.clear();
+                parallel::submit_for_all(task, [](auto& result, auto&& new_value) {
+                        if (result.empty()) {
+                                result = std::move(new_value);
+                        } else {
+                                for (size_t i = 0; i < result.size(); ++i) {
+                                        result[i].block_size += new_value[i].block_size;
+                                        result[i].block_weight += new_value[i].block_weight;
+                                }
+                        }
+                }, m_blocks_info);
+                std::cout << "Boundary size\t" << size() << std::endl;
+                CLOCK_END("Distribute boundary vertices");
+        }
+};
+
 //using boundary_type = parallel::fast_sequential_boundary;
 //using boundary_type = parallel::fast_parallel_boundary;
-using boundary_type = parallel::fast_parallel_boundary_exp;
+//using boundary_type = parallel::fast_parallel_boundary_exp;
+using boundary_type = parallel::fast_parallel_boundary_incremental;
 
 }
\ No newline at end of file
@@ -1,15 +1,18 @@
 #pragma once
 
+#include <limits>
 #include <vector>
 #include <map>
 #include "data_structure/graph_access.h"
 #include "data_structure/parallel/algorithm.h"
 #include "data_structure/parallel/atomics.h"
+#include "data_structure/parallel/block_connectivity.h"
 #include "data_structure/parallel/nodes_partitions_map.h"
 #include "data_structure/parallel/hash_table.h"
 #include "data_structure/parallel/spin_lock.h"
 #include "data_structure/parallel/thread_config.h"
 #include "data_structure/priority_queues/bucket_pq.h"
+#include "data_structure/priority_queues/fast_bucket_pq.h"
 #include "data_structure/priority_queues/maxNodeHeap.h"
 #include "definitions.h"
 #include "partition/partition_config.h"
@@ -17,6 +20,70 @@
 
 namespace parallel {
 
+// Thread local view of the block weights and sizes. Only blocks touched by the local searches
+// are stored on top of the values of the boundary, so a reset is linear in the number of touched
+// blocks and not in k.
+class local_block_weights {
+public:
+        local_block_weights(boundary_type& boundary, PartitionID k)
+                :       m_boundary(boundary)
+                ,       m_positions(k, sentinel)
+        {}
+
+        inline NodeWeight get_block_weight(PartitionID block) {
+                uint32_t pos = m_positions[block];
+                return pos == sentinel ? m_boundary.get_block_weight(block) : m_touched[pos].block_weight;
+        }
+
+        inline NodeID get_block_size(PartitionID block) {
+                uint32_t pos = m_positions[block];
+                return pos == sentinel ? m_boundary.get_block_size(block) : m_touched[pos].block_size;
+        }
+
+        inline void move(PartitionID from, PartitionID to, NodeWeight weight) {
+                auto& from_block = touch(from);
+                from_block.block_weight -= weight;
+                --from_block.block_size;
+
+                auto& to_block = touch(to);
+                to_block.block_weight += weight;
+                ++to_block.block_size;
+        }
+
+        inline size_t num_touched_blocks() const {
+                return m_touched.size();
+        }
+
+        void clear() {
+                for (const auto& block_data : m_touched) {
+                        m_positions[block_data.block] = sentinel;
+                }
+                m_touched.clear();
+        }
+
+private:
+        static constexpr uint32_t sentinel = std::numeric_limits<uint32_t>::max();
+
+        struct touched_block {
+                PartitionID block;
+                NodeWeight block_weight;
+                NodeID block_size;
+        };
+
+        boundary_type& m_boundary;
+        std::vector<uint32_t> m_positions;
+        std::vector<touched_block> m_touched;
+
+        inline touched_block& touch(PartitionID block) {
+                uint32_t& pos = m_positions[block];
+                if (pos == sentinel) {
+                        pos = m_touched.size();
+                        m_touched.push_back({block, m_boundary.get_block_weight(block), m_boundary.get_block_size(block)});
+                }
+                return m_touched[pos];
+        }
+};
+
 class thread_data_refinement_core : public parallel::thread_config {
 public:
         //using nodes_partitions_hash_table = parallel::hash_map<NodeID, PartitionID>;
@@ -33,19 +100,19 @@ public:
         int step_limit;
         std::vector<AtomicWrapper<bool>>& moved_idx;
 //        Cvector<AtomicWrapper<bool>>& moved_idx;
-//        Cvector<AtomicWrapper<NodeWeight>>& parts_weights;
-//        Cvector<AtomicWrapper<NodeWeight>>& parts_sizes;
         Cvector<AtomicWrapper<int>>& moved_count;
         AtomicWrapper<uint32_t>& num_threads_finished;
 
         // local thread data
         //std::vector<AtomicWrapper<bool>> moved_idx;
-        std::vector<NodeWeight> parts_weights;
-        std::vector<NodeWeight> parts_sizes;
+        local_block_weights parts_weights;
 
         boundary_starting_nodes start_nodes;
         std::unique_ptr<nodes_partitions_hash_table> nodes_partitions;
         std::unique_ptr<refinement_pq> queue;
+        // at most one of the specialized queues is used instead of the generic queue
+        std::unique_ptr<dense_bucket_pq> dense_queue;
+        std::unique_ptr<sparse_bucket_pq> sparse_queue;
         std::unique_ptr<ht_with_erase> move_to;
         std::vector<std::pair<int, int>> min_cut_indices;
         std::vector<NodeID> transpositions;
@@ -87,8 +154,6 @@ public:
                                     boundary_type& _boundary,
                                     std::vector <AtomicWrapper<bool>>& _moved_idx,
                                     //Cvector<AtomicWrapper<bool>>& _moved_idx,
-                                    Cvector<AtomicWrapper<NodeWeight>>& _parts_weights,
-                                    Cvector<AtomicWrapper<NodeWeight>>& _parts_sizes,
                                     Cvector<AtomicWrapper<int>>& _moved_count,
                                     AtomicWrapper<uint32_t>& _reset_counter,
                                     AtomicWrapper<uint32_t>& _num_threads_finished
@@ -100,12 +165,13 @@ public:
                 ,       step_limit(0)
                 ,       moved_idx(_moved_idx)
 //                ,       moved_idx(_G.number_of_nodes(), false)
-//                ,       parts_weights(_parts_weights)
-//                ,       parts_sizes(_parts_sizes)
                 ,       moved_count(_moved_count)
                 ,       num_threads_finished(_num_threads_finished)
+                ,       parts_weights(_boundary, _config.k)
                 ,       nodes_partitions(nullptr)
                 ,       queue(nullptr)
+                ,       dense_queue(nullptr)
+                ,       sparse_queue(nullptr)
                 ,       move_to(nullptr)
                 ,       total_thread_time(0.0)
                 ,       tried_movements(0)
@@ -128,15 +194,14 @@ public:
                 ,       stop_faction_of_nodes_moved(0)
                 ,       m_reset_counter(_reset_counter)
         {
+                if (config.refinement_objective == RefinementObjective::COMMUNICATION_VOLUME) {
+                        m_connectivity = std::make_unique<block_connectivity>(config.k);
+                }
+
                 size_t type_size = sizeof(round_struct);
                 m_local_degrees.resize(std::ceil((config.k + 0.0) * type_size / g_cache_line_size) * g_cache_line_size / type_size);
                 ALWAYS_ASSERT(m_local_degrees.size() % type_size == 0);
 
-                for (PartitionID block = 0; block < config.k; ++block) {
-                        parts_weights.push_back(boundary.get_block_weight(block));
-                        parts_sizes.push_back(boundary.get_block_size(block));
-                }
-
                 // needed for the computation of internal and external degrees
                 m_round = 0;
 
@@ -184,6 +249,9 @@ public:
         }
 
         inline void set_local_partition(NodeID id, PartitionID part_id) {
+                if (m_connectivity) {
+                        m_connectivity->move(G, id, get_local_partition(id), part_id);
+                }
                 (*nodes_partitions)[id] = part_id;
         }
 
@@ -196,23 +264,15 @@ public:
                         nodes_partitions =std::make_unique<nodes_partitions_hash_table>(G.number_of_nodes(), mem_size);
                 }
 
-                if (queue.get() == nullptr) {
-                        if (config.use_bucket_queues) {
-                                EdgeWeight max_degree = G.getMaxDegree();
-                                queue = std::make_unique<bucket_pq>(max_degree);
-                        } else {
-                                queue = std::make_unique<maxNodeHeap>();
-                        }
+                if (queue.get() == nullptr && dense_queue.get() == nullptr && sparse_queue.get() == nullptr) {
+                        init_queue();
                 }
 
                 if (move_to.get() == nullptr) {
                         move_to = std::make_unique<ht_with_erase>(128);
                 }
 
-                for (PartitionID block = 0; block < config.k; ++block) {
-                        parts_weights[block] = boundary.get_block_weight(block);
-                        parts_sizes[block] = boundary.get_block_size(block);
-                }
+                parts_weights.clear();
 
                 // ht
                 nodes_partitions->clear();
@@ -223,7 +283,13 @@ public:
                 //nodes_partitions.assign(G.number_of_nodes(), -1);
 
                 ////////nodes_partitions.reserve(nodes_partitions_hash_table::get_max_size_to_fit_l1());
-                queue->clear();
+                if (dense_queue) {
+                        dense_queue->clear();
+                } else if (sparse_queue) {
+                        sparse_queue->clear();
+                } else {
+                        queue->clear();
+                }
                 move_to->clear();
                 min_cut_indices.clear();
                 transpositions.clear();
@@ -244,15 +310,37 @@ public:
                 partial_reset_thread_data();
         }
 
+        // the block counts of volume gains are cached during one local search, outside of it the
+        // cache would grow with every start node and miss the moves of other threads
+        inline void set_gain_caching(bool enabled) {
+                m_cache_gains = enabled;
+                if (m_connectivity) {
+                        m_connectivity->clear_cache();
+                }
+        }
+
+        // with the volume objective the moves of a node change the gains of nodes in distance two
+        inline bool has_distance_two_gains() const {
+                return m_connectivity != nullptr;
+        }
+
         inline Gain compute_gain(NodeID node, PartitionID from, PartitionID& to, EdgeWeight& ext_degree) {
                 //ASSERT_TRUE(from == get_local_partition(node));
                 //for all incident partitions compute gain
                 //return max gain and "to" partition
+                if (m_connectivity) {
+                        Gain gain = compute_volume_gain(node, from, to, ext_degree, [this](NodeID target) {
+                                ++num_part_accesses;
+                                return get_local_partition(target);
+                        }, m_cache_gains);
+                        return num_threads_finished.load(std::memory_order_acq_rel) > 0 ? -1 : gain;
+                }
+
                 EdgeWeight max_degree = 0;
                 to = INVALID_PARTITION;
                 NodeID max_rnd = 0;
 
-                m_round++;//can become zero again
+                next_round();
                 forall_out_edges(G, e, node) {
                         NodeID target = G.getEdgeTarget(e);
                         PartitionID target_partition = get_local_partition(target);
@@ -311,13 +399,20 @@ public:
                 //ASSERT_TRUE(from == get_local_partition(node));
                 //for all incident partitions compute gain
                 //return max gain and "to" partition
+                if (m_connectivity) {
+                        EdgeWeight ext_degree = 0;
+                        return compute_volume_gain(node, from, to, ext_degree, [this](NodeID target) {
+                                return G.getPartitionIndex(target);
+                        }, false, desired_to);
+                }
+
                 EdgeWeight max_degree = 0;
                 to = INVALID_PARTITION;
                 bool found_desired_to = false;
                 EdgeWeight desired_to_degree = 0;
                 NodeID max_rnd = 0;
 
-                m_round++;//can become zero again
+                next_round();
                 forall_out_edges(G, e, node) {
                         NodeID target = G.getEdgeTarget(e);
                         PartitionID target_partition = G.getPartitionIndex(target);
@@ -368,8 +463,70 @@ public:
         }
 
 private:
+        // memory all threads may spend on dense queue indices
+        static constexpr size_t dense_pq_index_memory_limit = 1ull << 28;
+
         AtomicWrapper<uint32_t>& m_reset_counter;
 
+        // only allocated if the refinement optimizes the communication volume
+        std::unique_ptr<block_connectivity> m_connectivity;
+        bool m_cache_gains = false;
+
+        // the ext_degree of the volume gain is the number of neighbors in the target block,
+        // ties between blocks with the same gain are broken randomly unless desired_to is one of them.
+        // Only the local view of the thread may use the cached counts, G is changed by other threads.
+        template <typename partition_type>
+        inline Gain compute_volume_gain(NodeID node, PartitionID from, PartitionID& to, EdgeWeight& ext_degree,
+                                        partition_type&& get_partition, bool cached,
+                                        PartitionID desired_to = INVALID_PARTITION) {
+                if (cached) {
+                        m_connectivity->compute_cached_gains(G, node, from, get_partition);
+                } else {
+                        m_connectivity->compute_gains(G, node, from, get_partition);
+                }
+                const auto& candidates = m_connectivity->candidates();
+
+                Gain max_gain = 0;
+                NodeID max_rnd = 0;
+                to = INVALID_PARTITION;
+                for (size_t i = 0; i < candidates.size(); ++i) {
+                        Gain cur_gain = m_connectivity->gain(i);
+                        NodeID cur_rnd = rnd.random_number<NodeID>();
+                        if (to == INVALID_PARTITION || cur_gain > max_gain || (cur_gain == max_gain && cur_rnd > max_rnd)) {
+                                max_gain = cur_gain;
+                                to = candidates[i];
+                                max_rnd = cur_rnd;
+                        }
+                }
+
+                for (size_t i = 0; i < candidates.size(); ++i) {
+                        if (candidates[i] == desired_to && m_connectivity->gain(i) == max_gain) {
+                                to = desired_to;
+                        }
+                }
+
+                ext_degree = to != INVALID_PARTITION ? m_connectivity->count(to) : 0;
+                return max_gain;
+        }
+
+        void init_queue() {
+                // volume gains are bounded by the unweighted degree plus one
+                EdgeWeight max_degree = G.getMaxDegree() + (m_connectivity ? 1 : 0);
+                if (config.use_fast_bucket_queues && max_degree <= dense_bucket_pq::max_gain_span) {
+                        size_t dense_index_memory = (size_t) G.number_of_nodes() * config.num_threads *
+                                                    sizeof(bucket_pq_index_entry);
+                        if (dense_index_memory <= dense_pq_index_memory_limit) {
+                                dense_queue = std::make_unique<dense_bucket_pq>(max_degree, G.number_of_nodes());
+                        } else {
+                                sparse_queue = std::make_unique<sparse_bucket_pq>(max_degree, G.number_of_nodes());
+                        }
+                } else if (config.use_bucket_queues) {
+                        queue = std::make_unique<bucket_pq>(max_degree);
+                } else {
+                        queue = std::make_unique<maxNodeHeap>();
+                }
+        }
+
         inline bool is_all_data_reseted() const {
                 return m_reset_counter.load(std::memory_order_acquire) == config.num_threads;
         }
@@ -387,5 +544,15 @@ private:
 
         std::vector<round_struct> m_local_degrees;
         uint32_t m_round;
+
+        inline void next_round() {
+                if (++m_round == 0) {
+                        // stamps of old rounds would become valid again
+                        for (auto& degree : m_local_degrees) {
+                                degree.round = 0;
+                        }
+                        m_round = 1;
+                }
+        }
 };
 }
\ No newline at end of file
@@ -36,19 +36,27 @@ constexpr int kway_graph_refinement_core::signed_sentinel;
 
 std::tuple<EdgeWeight, int, uint32_t>
 kway_graph_refinement_core::single_kway_refinement_round(thread_data_refinement_core& td) {
-        return single_kway_refinement_round_internal(td);
+        // dispatch once per round so that all queue operations of the local search can be inlined
+        if (td.dense_queue) {
+                return single_kway_refinement_round_internal(td, *td.dense_queue);
+        }
+        if (td.sparse_queue) {
+                return single_kway_refinement_round_internal(td, *td.sparse_queue);
+        }
+        return single_kway_refinement_round_internal(td, *td.queue);
 }
 
+template <typename queue_type>
 std::tuple<EdgeWeight, int, uint32_t>
-kway_graph_refinement_core::single_kway_refinement_round_internal(thread_data_refinement_core& td) {
-        auto& queue = td.queue;
-
-        queue->clear();
+kway_graph_refinement_core::single_kway_refinement_round_internal(thread_data_refinement_core& td,
+                                                                  queue_type& queue) {
+        queue.clear();
         td.move_to->clear();
+        td.set_gain_caching(true);
 
         init_queue_with_boundary(td, queue);
 
-        if (queue->empty() || td.num_threads_finished.load(std::memory_order_acq_rel) > 0) {
+        if (queue.empty() || td.num_threads_finished.load(std::memory_order_acq_rel) > 0) {
                 td.transpositions.push_back(sentinel);
                 td.from_partitions.push_back(sentinel);
                 td.to_partitions.push_back(sentinel);
@@ -87,7 +95,7 @@ kway_graph_refinement_core::single_kway_refinement_round_internal(thread_data_re
         // minus 1 for sentinel
         int min_cut_index = previously_moved - 1;
         for (number_of_swaps = 0, movements = 0; (int32_t) movements < max_number_of_swaps; movements++, number_of_swaps++) {
-                if (queue->empty()) {
+                if (queue.empty()) {
                         ++td.stop_empty_queue;
                         break;
                 }
@@ -101,13 +109,23 @@ kway_graph_refinement_core::single_kway_refinement_round_internal(thread_data_re
                         break;
                 }
 
-                Gain gain = queue->maxValue();
-                NodeID node = queue->deleteMax();
+                Gain gain = queue.maxValue();
+                NodeID node = queue.deleteMax();
 
                 PartitionID from = td.get_local_partition(node);
                 PartitionID to = td.get_local_partition_to_move(node);
                 td.remove_local_partition_to_move(node);
 
+                if (td.has_distance_two_gains()) {
+                        // moves of nodes in distance two changed the gain without updating the queue
+                        EdgeWeight ext_degree;
+                        gain = td.compute_gain(node, from, to, ext_degree);
+                        if (to == INVALID_PARTITION) {
+                                number_of_swaps--;
+                                continue;
+                        }
+                }
+
                 if (td.num_threads_finished.load(std::memory_order_acq_rel) > 0) {
                         break;
                 }
@@ -156,6 +174,7 @@ kway_graph_refinement_core::single_kway_refinement_round_internal(thread_data_re
         uint32_t unrolled_moves = unroll_moves(td, min_cut_index);
         td.accepted_movements -= unrolled_moves;
         td.nodes_partitions->clear();
+        td.set_gain_caching(false);
 
         td.transpositions.push_back(sentinel);
         td.from_partitions.push_back(sentinel);
@@ -191,7 +210,7 @@ EdgeWeight kway_graph_refinement_core::apply_moves(uint32_t num_threads,
         std::atomic<uint32_t> thread_id(0);
         std::vector<AtomicWrapper<uint32_t>> offsets(num_threads, 0);
 
-        if (parallel::g_thread_pool.NumThreads() > 0) {
+        if (parallel::current_thread_pool().NumThreads() > 0) {
                 CLOCK_START;
                 threads_data[0].get().boundary.begin_movements();
                 threads_data[0].get().time_move_nodes_change_boundary += CLOCK_END_TIME;
@@ -222,7 +241,7 @@ std::vector<std::future<void>> kway_graph_refinement_core::prepare_boundary(uint
                                                                             std::vector<AtomicWrapper<uint32_t>>& offsets) const {
 
         std::vector<std::future<void>> futures;
-        futures.reserve(parallel::g_thread_pool.NumThreads());
+        futures.reserve(parallel::current_thread_pool().NumThreads());
         auto task = [&, num_threads]() {
                 while (true) {
                         uint32_t cur_thread_id = thread_id.load(std::memory_order_relaxed);
@@ -270,8 +289,8 @@ std::vector<std::future<void>> kway_graph_refinement_core::prepare_boundary(uint
 
         {
                 CLOCK_START;
-                for (size_t i = 0; i < parallel::g_thread_pool.NumThreads(); ++i) {
-                        futures.push_back(parallel::g_thread_pool.Submit(i, task));
+                for (size_t i = 0; i < parallel::current_thread_pool().NumThreads(); ++i) {
+                        futures.push_back(parallel::current_thread_pool().Submit(i, task));
                 }
                 threads_data[0].get().time_move_nodes_change_boundary += CLOCK_END_TIME;
         }
@@ -281,7 +300,7 @@ std::vector<std::future<void>> kway_graph_refinement_core::prepare_boundary(uint
 
 void kway_graph_refinement_core::update_boundary(thread_data_refinement_core& td) const {
         //CLOCK_START;
-        if (parallel::g_thread_pool.NumThreads() > 0) {
+        if (parallel::current_thread_pool().NumThreads() > 0) {
                 CLOCK_START;
                 td.boundary.finish_movements();
                 td.time_move_nodes_change_boundary += CLOCK_END_TIME;
@@ -342,7 +361,7 @@ EdgeWeight kway_graph_refinement_core::apply_moves(thread_data_refinement_core&
                                 same_move = false;
                                 ++td.affected_movements;
                                 ++aff;
-                                if (g_thread_pool.NumThreads() > 0 && m_maintain_complete_boundary) {
+                                if (current_thread_pool().NumThreads() > 0 && m_maintain_complete_boundary) {
                                         CLOCK_START;
                                         auto task = [&td] (NodeID cur_node, PartitionID to, PartitionID from) {
                                                 forall_out_edges(td.G, e, cur_node) {
@@ -353,8 +372,8 @@ EdgeWeight kway_graph_refinement_core::apply_moves(thread_data_refinement_core&
                                                         }
                                                 } endfor
                                         };
-                                        uint32_t thread_id = td.rnd.random_number(0u, (uint32_t) parallel::g_thread_pool.NumThreads() - 1);
-                                        futures.push_back(parallel::g_thread_pool.Submit(thread_id, task, node, to, from));
+                                        uint32_t thread_id = td.rnd.random_number(0u, (uint32_t) parallel::current_thread_pool().NumThreads() - 1);
+                                        futures.push_back(parallel::current_thread_pool().Submit(thread_id, task, node, to, from));
                                         td.time_move_nodes_change_boundary += CLOCK_END_TIME;
                                 }
                         }
@@ -409,8 +428,8 @@ EdgeWeight kway_graph_refinement_core::apply_moves(thread_data_refinement_core&
         return cut_improvement;
 }
 
-void kway_graph_refinement_core::init_queue_with_boundary(thread_data_refinement_core& td,
-                                                          std::unique_ptr<refinement_pq>& queue) {
+template <typename queue_type>
+void kway_graph_refinement_core::init_queue_with_boundary(thread_data_refinement_core& td, queue_type& queue) {
         if (td.config.permutation_during_refinement == PERMUTATION_QUALITY_FAST) {
                 random_functions::permutate_vector_fast(td.start_nodes, false);
         } else if (td.config.permutation_during_refinement == PERMUTATION_QUALITY_GOOD) {
@@ -431,7 +450,7 @@ void kway_graph_refinement_core::init_queue_with_boundary(thread_data_refinement
                                 return;
                         }
 
-                        queue->insert(node, gain);
+                        queue.insert(node, gain);
                         td.set_local_partition_to_move(node, to);
                         td.moved.push_back(node);
                 }
@@ -456,7 +475,7 @@ inline bool kway_graph_refinement_core::relaxed_move_node(thread_data_refinement
 
         td.G.setPartitionIndex(node, to);
 
-        if (parallel::g_thread_pool.NumThreads() == 0) {
+        if (parallel::current_thread_pool().NumThreads() == 0) {
                 CLOCK_START;
                 td.boundary.move(node, from, to);
                 auto t = CLOCK_END_TIME;
@@ -492,7 +511,7 @@ void kway_graph_refinement_core::relaxed_move_node_back(thread_data_refinement_c
         ALWAYS_ASSERT(td.G.getPartitionIndex(node) == to);
         td.G.setPartitionIndex(node, from);
 
-        if (parallel::g_thread_pool.NumThreads() == 0) {
+        if (parallel::current_thread_pool().NumThreads() == 0) {
                 CLOCK_START;
                 td.boundary.move(node, to, from);
                 auto t = CLOCK_END_TIME;
@@ -512,26 +531,17 @@ inline bool kway_graph_refinement_core::local_move_back_node(thread_data_refinem
                                                              PartitionID to) const {
         // td.set_local_partition(node, from);
         NodeWeight this_nodes_weight = td.G.getNodeWeight(node);
-
-//        td.parts_weights[from].get().fetch_add(this_nodes_weight, std::memory_order_relaxed);
-//        td.parts_weights[to].get().fetch_sub(this_nodes_weight, std::memory_order_relaxed);
-//        td.parts_sizes[to].get().fetch_sub(1, std::memory_order_relaxed);
-//        td.parts_sizes[from].get().fetch_add(1, std::memory_order_relaxed);
-
-        td.parts_weights[from] += this_nodes_weight;
-        td.parts_weights[to] -= this_nodes_weight;
-        --td.parts_sizes[to];
-        ++td.parts_sizes[from];
-
+        td.parts_weights.move(to, from, this_nodes_weight);
 
         return true;
 };
 
+template <typename queue_type>
 inline bool kway_graph_refinement_core::local_move_node(thread_data_refinement_core& td,
                                                        NodeID node,
                                                        PartitionID from,
                                                        PartitionID to,
-                                                       std::unique_ptr<refinement_pq>& queue, Gain gain) {
+                                                       queue_type& queue, Gain gain) {
 
 //        EdgeWeight node_ext_deg;
 //        PartitionID expected_to;
@@ -560,35 +570,26 @@ inline bool kway_graph_refinement_core::local_move_node(thread_data_refinement_c
 //                                                                   part_weight + this_nodes_weight,
 //                                                                   std::memory_order_relaxed));
 
-        if (td.parts_sizes[from] == 1) {
+        if (td.parts_weights.get_block_size(from) == 1) {
                 return false;
         }
 
-        NodeWeight part_weight = td.parts_weights[to];
-
-        if (part_weight + this_nodes_weight >= td.config.upper_bound_partition) {
+        if (td.parts_weights.get_block_weight(to) + this_nodes_weight >= td.config.upper_bound_partition) {
                 return false;
         }
-        td.parts_weights[to] = part_weight + this_nodes_weight;
-
 
         td.set_local_partition(node, to);
-//        td.parts_weights[from].get().fetch_sub(this_nodes_weight, std::memory_order_relaxed);
-//        td.parts_sizes[to].get().fetch_add(1, std::memory_order_relaxed);
-//        td.parts_sizes[from].get().fetch_sub(1, std::memory_order_relaxed);
-
-        td.parts_weights[from] -= this_nodes_weight;
-        ++td.parts_sizes[to];
-        --td.parts_sizes[from];
+        td.parts_weights.move(from, to, this_nodes_weight);
 
         //update gain of neighbors / the boundaries have allready been updated
+        //with the volume objective nodes in distance two change their gain as well, they are recomputed once popped
         forall_out_edges(td.G, e, node) {
                 ++td.scaned_neighbours;
                 NodeID target = td.G.getEdgeTarget(e);
                 PartitionID targets_to;
                 EdgeWeight ext_degree; // the local external degree
 
-                if (queue->contains(target)) {
+                if (queue.contains(target)) {
                         PartitionID target_from = td.get_local_partition(target);
 
                         Gain gain = td.compute_gain(target, target_from, targets_to, ext_degree);
@@ -599,10 +600,10 @@ inline bool kway_graph_refinement_core::local_move_node(thread_data_refinement_c
 
                         assert(td.moved_idx[target].load(std::memory_order_relaxed));
                         if (ext_degree > 0) {
-                                queue->changeKey(target, gain);
+                                queue.changeKey(target, gain);
                                 td.set_local_partition_to_move(target, targets_to);
                         } else {
-                                queue->deleteNode(target);
+                                queue.deleteNode(target);
                                 td.remove_local_partition_to_move(target);
                         }
                 } else {
@@ -623,7 +624,7 @@ inline bool kway_graph_refinement_core::local_move_node(thread_data_refinement_c
                                 bool expected = false;
                                 if (td.moved_idx[target].compare_exchange_strong(expected, true,
                                                                                  std::memory_order_relaxed)) {
-                                        queue->insert(target, gain);
+                                        queue.insert(target, gain);
                                         td.set_local_partition_to_move(target, targets_to);
                                         td.moved.push_back(target);
                                 }
@@ -32,18 +32,21 @@ private:
         static constexpr unsigned int sentinel = std::numeric_limits<unsigned int>::max();
         static constexpr int signed_sentinel = std::numeric_limits<int>::max();
 
-        std::tuple<EdgeWeight, int, uint32_t> single_kway_refinement_round_internal(thread_data_refinement_core& td);
+        template <typename queue_type>
+        std::tuple<EdgeWeight, int, uint32_t> single_kway_refinement_round_internal(thread_data_refinement_core& td,
+                                                                                    queue_type& queue);
 
         std::vector<std::future<void>> prepare_boundary(uint32_t num_threads,
                                                         Cvector <thread_data_refinement_core>& threads_data,
                                                         std::atomic<uint32_t>& thread_id,
                                                         std::vector<AtomicWrapper<uint32_t>>& offsets) const;
 
-        void init_queue_with_boundary(thread_data_refinement_core& config,
-                                      std::unique_ptr<refinement_pq>& queue);
+        template <typename queue_type>
+        void init_queue_with_boundary(thread_data_refinement_core& config, queue_type& queue);
 
+        template <typename queue_type>
         inline bool local_move_node(thread_data_refinement_core& config, NodeID node, PartitionID from, PartitionID to,
-                                    std::unique_ptr<refinement_pq>& queue, Gain gain);
+                                    queue_type& queue, Gain gain);
 
         void unroll_relaxed_moves(thread_data_refinement_core& td,
                                   std::vector<NodeID>& transpositions,
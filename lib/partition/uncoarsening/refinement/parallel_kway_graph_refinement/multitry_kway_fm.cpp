@@ -6,7 +6,7 @@
 
 namespace parallel {
 
-std::vector<thread_data_factory::statistics_type> thread_data_factory::m_statistics;
+thread_local std::vector<thread_data_factory::statistics_type> thread_data_factory::m_statistics;
 
 int multitry_kway_fm::perform_refinement(PartitionConfig& config, graph_access& G, boundary_type& boundary,
                                          unsigned rounds, bool init_neighbors, unsigned alpha) {
@@ -46,6 +46,9 @@ int multitry_kway_fm::perform_refinement(PartitionConfig& config, graph_access&
                 }
 
                 decide_if_stop(LoopType::Global, config, iter, rounds, est, work, improvement, overall_improvement, stop);
+                if (deadline_reached(config.deadline)) {
+                        stop = true;
+                }
 
                 add_value(est, (work + 0.0) / improvement);
                 overall_improvement += improvement;
@@ -160,7 +163,8 @@ void multitry_kway_fm::decide_if_stop(LoopType type, PartitionConfig& config, ui
 
 int multitry_kway_fm::start_more_locallized_search(graph_access& G, PartitionConfig& config, bool init_neighbors, uint32_t rounds) {
         uint32_t num_threads = config.num_threads;
-        parallel::kway_graph_refinement_core refinement_core;
+        // the boundary is projected to the next level, so it has to stay complete
+        parallel::kway_graph_refinement_core refinement_core(true);
         int local_step_limit = 50;
 
         CLOCK_START;
@@ -301,7 +305,7 @@ int multitry_kway_fm::start_more_locallized_search(graph_access& G, PartitionCon
                 auto accesses_before = m_factory.get_total_num_part_accesses();
 
                 for (uint32_t id = 1; id < num_threads; ++id) {
-                        futures.push_back(parallel::g_thread_pool.Submit(id - 1, task, id));
+                        futures.push_back(parallel::current_thread_pool().Submit(id - 1, task, id));
                 }
 
                 bool is_more_that_5percent_moved = task(0);
@@ -335,6 +339,9 @@ int multitry_kway_fm::start_more_locallized_search(graph_access& G, PartitionCon
                 }
 
                 decide_if_stop(LoopType::Local, config, iter, rounds, est, work, real_gain_improvement, total_gain_improvement, stop);
+                if (deadline_reached(config.deadline)) {
+                        stop = true;
+                }
                 ++iter;
                 add_value(est, (work + 0.0) / real_gain_improvement);
                 total_gain_improvement += real_gain_improvement;
@@ -437,6 +444,30 @@ void multitry_kway_fm::setup_start_nodes_all(graph_access& G, PartitionConfig& c
         shuffle_task_queue();
 }
 
+void multitry_kway_fm::setup_start_nodes_all(graph_access& G, PartitionConfig& config, parallel::fast_parallel_boundary_incremental& boundary) {
+        ALWAYS_ASSERT(config.num_threads > 0);
+        const auto& bitmap = boundary.get_bitmap();
+        const size_t num_words = bitmap.num_words();
+        const size_t block_size = std::max<size_t>(sqrt(num_words), 16);
+        std::atomic<size_t> offset(0);
+        parallel::submit_for_all([this, &bitmap, &offset, num_words, block_size](uint32_t thread_id) {
+                auto& thread_container = m_factory.queue[thread_id];
+                size_t begin = offset.fetch_add(block_size, std::memory_order_relaxed);
+
+                while (begin < num_words) {
+                        bitmap.for_each_set_bit(begin, std::min(begin + block_size, num_words), [&thread_container](NodeID node) {
+                                thread_container.push_back(node);
+                        });
+                        begin = offset.fetch_add(block_size, std::memory_order_relaxed);
+                }
+
+                auto& td = m_factory.get_thread_data(thread_id);
+                td.rnd.shuffle(thread_container.begin(), thread_container.end());
+        });
+
+        shuffle_task_queue();
+}
+
 void  multitry_kway_fm::shuffle_task_queue() {
         auto& td = m_factory.get_thread_data(0);
 
@@ -448,7 +479,7 @@ int multitry_kway_fm::start_more_locallized_search_experimental(PartitionConfig&
                                                                 bool init_neighbors,
                                                                 std::vector<NodeID>& todolist) {
         uint32_t num_threads = config.num_threads;
-        parallel::kway_graph_refinement_core refinement_core;
+        parallel::kway_graph_refinement_core refinement_core(true);
         int local_step_limit = 50;
 
         ALWAYS_ASSERT(config.apply_move_strategy != ApplyMoveStrategy::REACTIVE_VERTICES);
@@ -566,8 +597,8 @@ int multitry_kway_fm::start_more_locallized_search_experimental(PartitionConfig&
                 futures.reserve(num_threads - 1);
 
                 for (uint32_t id = 1; id < num_threads; ++id) {
-                        futures.push_back(parallel::g_thread_pool.Submit(id - 1, task, id));
-                        //futures.push_back(parallel::g_thread_pool.Submit(task, id));
+                        futures.push_back(parallel::current_thread_pool().Submit(id - 1, task, id));
+                        //futures.push_back(parallel::current_thread_pool().Submit(task, id));
                 }
 
                 bool is_more_that_5percent_moved = task(0);
@@ -652,11 +683,11 @@ int multitry_kway_fm::start_more_locallized_search_experimental(PartitionConfig&
 //        };
 //
 //        std::vector<std::future<void>> futures;
-//        futures.reserve(parallel::g_thread_pool.NumThreads());
+//        futures.reserve(parallel::current_thread_pool().NumThreads());
 //
-//        for (uint32_t id = 0; id < parallel::g_thread_pool.NumThreads(); ++id) {
-//                futures.push_back(parallel::g_thread_pool.Submit(id, task, id + 1));
-//                //futures.push_back(parallel::g_thread_pool.Submit(task, id + 1));
+//        for (uint32_t id = 0; id < parallel::current_thread_pool().NumThreads(); ++id) {
+//                futures.push_back(parallel::current_thread_pool().Submit(id, task, id + 1));
+//                //futures.push_back(parallel::current_thread_pool().Submit(task, id + 1));
 //        }
 //
 //        task(0);
@@ -710,11 +741,11 @@ int multitry_kway_fm::start_more_locallized_search_experimental(PartitionConfig&
 //        };
 //
 //        std::vector<std::future<void>> futures;
-//        futures.reserve(parallel::g_thread_pool.NumThreads());
+//        futures.reserve(parallel::current_thread_pool().NumThreads());
 //
-//        for (uint32_t id = 0; id < parallel::g_thread_pool.NumThreads(); ++id) {
-//                futures.push_back(parallel::g_thread_pool.Submit(id, task, id + 1));
-//                //futures.push_back(parallel::g_thread_pool.Submit(task, id + 1));
+//        for (uint32_t id = 0; id < parallel::current_thread_pool().NumThreads(); ++id) {
+//                futures.push_back(parallel::current_thread_pool().Submit(id, task, id + 1));
+//                //futures.push_back(parallel::current_thread_pool().Submit(task, id + 1));
 //        }
 //
 //        task(0);
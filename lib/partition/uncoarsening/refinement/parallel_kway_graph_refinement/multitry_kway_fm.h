@@ -32,16 +32,9 @@ public:
                 ,       m_G(G)
                 ,       m_boundary(boundary)
                 ,       m_moved_idx(G.number_of_nodes())
-                ,       m_parts_weights(config.k)
-                ,       m_parts_sizes(config.k)
                 ,       m_moved_count(config.num_threads)
                 ,       m_reset_counter(0)
         {
-                for (PartitionID block = 0; block < G.get_partition_count(); ++block) {
-                        m_parts_weights[block].get().store(boundary.get_block_weight(block), std::memory_order_relaxed);
-                        m_parts_sizes[block].get().store(boundary.get_block_size(block), std::memory_order_relaxed);
-                }
-
                 m_thread_data.reserve(config.num_threads);
 
                 for (uint32_t id = 0; id < config.num_threads; ++id) {
@@ -51,8 +44,6 @@ public:
                                                    G,
                                                    boundary,
                                                    m_moved_idx,
-                                                   m_parts_weights,
-                                                   m_parts_sizes,
                                                    m_moved_count,
                                                    m_reset_counter,
                                                    num_threads_finished);
@@ -74,11 +65,6 @@ public:
         }
 
         void partial_reset_global_data() {
-                for (PartitionID block = 0; block < m_G.get_partition_count(); ++block) {
-                        m_parts_weights[block].get().store(m_boundary.get_block_weight(block), std::memory_order_relaxed);
-                        m_parts_sizes[block].get().store(m_boundary.get_block_size(block), std::memory_order_relaxed);
-                }
-
                 m_reset_counter.store(0, std::memory_order_relaxed);
                 queue.clear();
                 num_threads_finished.store(0, std::memory_order_relaxed);
@@ -481,7 +467,8 @@ public:
                 }
         };
 
-        static std::vector<statistics_type> m_statistics;
+        // per thread, since partitioning calls of different sessions run at the same time
+        thread_local static std::vector<statistics_type> m_statistics;
         Cvector<thread_data_refinement_core> m_thread_data;
 
 #ifndef COMPARE_WITH_SEQUENTIAL_KAHIP
@@ -493,8 +480,6 @@ public:
         // global data
         std::vector<AtomicWrapper<bool>> m_moved_idx;
         //Cvector<AtomicWrapper<bool>> m_moved_idx;
-        Cvector <AtomicWrapper<NodeWeight>> m_parts_weights;
-        Cvector <AtomicWrapper<NodeWeight>> m_parts_sizes;
         Cvector <AtomicWrapper<int>> m_moved_count;
         AtomicWrapper<uint32_t> m_reset_counter;
 };
@@ -596,6 +581,8 @@ private:
         void setup_start_nodes_all(graph_access& G, PartitionConfig& config, parallel::fast_parallel_boundary& boundary);
 
         void setup_start_nodes_all(graph_access& G, PartitionConfig& config, parallel::fast_parallel_boundary_exp& boundary);
+
+        void setup_start_nodes_all(graph_access& G, PartitionConfig& config, parallel::fast_parallel_boundary_incremental& boundary);
 };
 
 }
\ No newline at end of file
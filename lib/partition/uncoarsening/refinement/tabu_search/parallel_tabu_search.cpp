@@ -0,0 +1,98 @@
+#include "data_structure/parallel/algorithm.h"
+#include "data_structure/parallel/thread_pool.h"
+#include "quality_metrics.h"
+#include "random_functions.h"
+#include "uncoarsening/refinement/quotient_graph_refinement/complete_boundary.h"
+#include "uncoarsening/refinement/tabu_search/parallel_tabu_search.h"
+#include "uncoarsening/refinement/tabu_search/tabu_search.h"
+
+#include <memory>
+
+#include <unistd.h>
+
+namespace parallel {
+
+EdgeWeight tabu_search::perform_refinement(PartitionConfig& config, graph_access& G) {
+        quality_metrics qm;
+        const EdgeWeight input_cut = qm.edge_cut(G);
+        const int seed = random_functions::nextInt(0, std::numeric_limits<int>::max() - 1024);
+
+        using result_type = std::pair<EdgeWeight, std::unique_ptr<PartitionID[]>>;
+        auto search = [&](uint32_t id) -> result_type {
+                if (id > 0) {
+                        random_functions::setSeed(seed + id);
+                }
+
+                // the threads share the nodes and edges of G and only own the partition
+                graph_access my_graph;
+                G.share_topology(my_graph);
+                my_graph.set_partition_count(G.get_partition_count());
+                forall_nodes(G, node) {
+                        my_graph.setPartitionIndex(node, G.getPartitionIndex(node));
+                } endfor
+
+                complete_boundary boundary(&my_graph);
+                boundary.build();
+
+                PartitionConfig my_config = config;
+                ::tabu_search ts;
+                ts.perform_refinement(my_config, my_graph, boundary);
+
+                auto partition = std::make_unique<PartitionID[]>(G.number_of_nodes());
+                forall_nodes(my_graph, node) {
+                        partition[node] = my_graph.getPartitionIndex(node);
+                } endfor
+
+                quality_metrics qm;
+                return std::make_pair(qm.edge_cut(my_graph), std::move(partition));
+        };
+
+        // the searches are the same as without the memory bound, only fewer of them run at the same time
+        const uint32_t num_searches = current_thread_pool().NumThreads() + 1;
+        const uint32_t num_concurrent = max_concurrent_searches(G, config.k, num_searches);
+        std::vector<result_type> results(num_searches);
+        auto task = [&](uint32_t thread_id) {
+                for (uint32_t id = thread_id; id < num_searches; id += num_concurrent) {
+                        results[id] = search(id);
+                }
+        };
+
+        std::vector<std::future<void>> futures;
+        futures.reserve(num_concurrent - 1);
+        for (uint32_t id = 1; id < num_concurrent; ++id) {
+                futures.push_back(current_thread_pool().Submit(id - 1, task, id));
+        }
+        task(0);
+        std::for_each(futures.begin(), futures.end(), [&](auto& future) {
+                future.get();
+        });
+
+        auto best = std::min_element(results.begin(), results.end(), [](const auto& lhs, const auto& rhs) {
+                return lhs.first < rhs.first;
+        });
+        if (best->first >= input_cut) {
+                return 0;
+        }
+
+        const PartitionID* best_partition = best->second.get();
+        parallel_for_index(NodeID(0), G.number_of_nodes(), [&](NodeID node) {
+                G.setPartitionIndex(node, best_partition[node]);
+        });
+        return input_cut - best->first;
+}
+
+uint32_t tabu_search::max_concurrent_searches(graph_access& G, PartitionID k, uint32_t num_searches) {
+        long pages = sysconf(_SC_AVPHYS_PAGES);
+        long page_size = sysconf(_SC_PAGESIZE);
+        if (pages <= 0 || page_size <= 0) {
+                return num_searches;
+        }
+
+        // the two matrices and three partition arrays of a search
+        uint64_t search_memory = ((uint64_t) 2 * k * sizeof(int) + 3 * sizeof(PartitionID)) * G.number_of_nodes();
+        uint64_t available = (uint64_t) pages * page_size / 2;
+        uint64_t num_concurrent = available / std::max<uint64_t>(search_memory, 1);
+        return (uint32_t) std::max<uint64_t>(1, std::min<uint64_t>(num_searches, num_concurrent));
+}
+
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "data_structure/graph_access.h"
+#include "partition_config.h"
+
+namespace parallel {
+
+// One sequential tabu search per thread, each with its own seed and tenure on a private copy of the
+// partition, the lightest cut is kept. Every search allocates two n x k matrices, so fewer searches run
+// at the same time if they would not fit into half of the available memory.
+class tabu_search {
+public:
+        // returns the improvement of the cut
+        EdgeWeight perform_refinement(PartitionConfig& config, graph_access& G);
+
+private:
+        static uint32_t max_concurrent_searches(graph_access& G, PartitionID k, uint32_t num_searches);
+};
+
+}
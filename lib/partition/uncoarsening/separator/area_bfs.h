@@ -23,6 +23,11 @@ class area_bfs {
 				std::vector< NodeID > & reached_nodes) {
 
 
+			// every thread has its own markers, they are created on first use
+			if( m_deepth.size() < G.number_of_nodes()) {
+				m_deepth.resize(G.number_of_nodes(), 0);
+			}
+
 			// for correctness, in practice will almost never be called
 			if( round == std::numeric_limits<int>::max()) {
 				round = 0;
@@ -78,8 +83,8 @@ class area_bfs {
 			}
 		}
 
-		static std::vector<int> m_deepth;
-		static int round;
+		static thread_local std::vector<int> m_deepth;
+		static thread_local int round;
 
 };
 
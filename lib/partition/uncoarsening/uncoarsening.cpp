@@ -46,7 +46,9 @@ uncoarsening::~uncoarsening() {
 int uncoarsening::perform_uncoarsening(const PartitionConfig & config, graph_hierarchy & hierarchy) {
 
         if(config.mode_node_separators) {
-                if( config.faster_ns ) {
+                if( config.parallel_node_separator ) {
+                        return parallel::uncoarsening().perform_uncoarsening_nodeseparator(config, hierarchy);
+                } else if( config.faster_ns ) {
                         return perform_uncoarsening_nodeseparator_fast(config, hierarchy);
                 } else {
                         return perform_uncoarsening_nodeseparator(config, hierarchy);
@@ -188,7 +190,7 @@ int uncoarsening::perform_uncoarsening_cut(const PartitionConfig & config, graph
 		if(to_delete != NULL) {
 			delete to_delete;
 		}
-		if(!hierarchy.isEmpty()) {
+		if(!hierarchy.isEmpty() && !hierarchy.is_persistent()) {
 			to_delete = G;
 		}
 
@@ -203,7 +205,9 @@ int uncoarsening::perform_uncoarsening_cut(const PartitionConfig & config, graph
 
         delete refine;
         if(finer_boundary != NULL) delete finer_boundary;
-	delete coarsest;
+	if(!hierarchy.is_persistent()) {
+		delete coarsest;
+	}
 
         return improvement;
 }
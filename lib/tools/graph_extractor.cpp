@@ -21,6 +21,7 @@
  *****************************************************************************/
 
 #include <unordered_map>
+#include "data_structure/parallel/algorithm.h"
 #include "graph_extractor.h"
 
 
@@ -71,6 +72,80 @@ void graph_extractor::extract_block(graph_access & G,
 }
 
 
+void graph_extractor::extract_block(graph_access & G,
+                                    graph_access & extracted_block,
+                                    PartitionID block,
+                                    const std::vector<NodeID> & block_nodes,
+                                    const std::vector<NodeID> & local_ids) {
+
+        EdgeID edges = 0;
+        for( NodeID node : block_nodes ) {
+                edges += G.getNodeDegree(node);
+        }
+
+        extracted_block.start_construction(block_nodes.size(), edges);
+
+        for( NodeID node : block_nodes ) {
+                NodeID new_node = extracted_block.new_node();
+                extracted_block.setNodeWeight( new_node, G.getNodeWeight(node));
+
+                forall_out_edges(G, e, node) {
+                        NodeID target = G.getEdgeTarget(e);
+                        if( G.getPartitionIndex( target ) == block ) {
+                                EdgeID new_edge = extracted_block.new_edge(new_node, local_ids[target]);
+                                extracted_block.setEdgeWeight(new_edge, G.getEdgeWeight(e));
+                        }
+                } endfor
+        }
+
+        extracted_block.finish_construction();
+}
+
+void graph_extractor::parallel_extract_block(graph_access & G,
+                                             graph_access & extracted_block,
+                                             PartitionID block,
+                                             const std::vector<NodeID> & block_nodes,
+                                             const std::vector<NodeID> & local_ids) {
+
+        // count the edges inside the block, firstEdge temporarily holds the degree
+        std::vector<Node> nodes(block_nodes.size() + 1);
+        parallel::parallel_for_index(NodeID(0), (NodeID) block_nodes.size(), [&](NodeID new_node) {
+                NodeID node = block_nodes[new_node];
+                EdgeID degree = 0;
+                forall_out_edges(G, e, node) {
+                        if( G.getPartitionIndex( G.getEdgeTarget(e) ) == block ) {
+                                degree++;
+                        }
+                } endfor
+                nodes[new_node].firstEdge = degree;
+                nodes[new_node].weight    = G.getNodeWeight(node);
+        });
+
+        EdgeID edges = 0;
+        for( NodeID new_node = 0; new_node < block_nodes.size(); new_node++) {
+                EdgeID degree = nodes[new_node].firstEdge;
+                nodes[new_node].firstEdge = edges;
+                edges += degree;
+        }
+        nodes.back().firstEdge = edges;
+        nodes.back().weight    = 0;
+
+        std::vector<Edge> edge_array(edges);
+        parallel::parallel_for_index(NodeID(0), (NodeID) block_nodes.size(), [&](NodeID new_node) {
+                EdgeID new_edge = nodes[new_node].firstEdge;
+                forall_out_edges(G, e, block_nodes[new_node]) {
+                        NodeID target = G.getEdgeTarget(e);
+                        if( G.getPartitionIndex( target ) == block ) {
+                                edge_array[new_edge].target = local_ids[target];
+                                edge_array[new_edge].weight = G.getEdgeWeight(e);
+                                new_edge++;
+                        }
+                } endfor
+        });
+
+        extracted_block.start_construction(nodes, edge_array);
+}
+
 void graph_extractor::extract_two_blocks(graph_access & G, 
                                          graph_access & extracted_block_lhs, 
                                          graph_access & extracted_block_rhs, 
@@ -36,6 +36,22 @@ class graph_extractor {
                                    PartitionID block, 
                                    std::vector<NodeID> & mapping);
 
+                // extracts the block induced by block_nodes without scanning the whole graph,
+                // local_ids[v] is the position of v in the node list of its block.
+                // several blocks can be extracted concurrently since G is only read
+                void extract_block(graph_access & G,
+                                   graph_access & extracted_block,
+                                   PartitionID block,
+                                   const std::vector<NodeID> & block_nodes,
+                                   const std::vector<NodeID> & local_ids);
+
+                // same as above, the nodes of the block are processed by the thread pool
+                void parallel_extract_block(graph_access & G,
+                                            graph_access & extracted_block,
+                                            PartitionID block,
+                                            const std::vector<NodeID> & block_nodes,
+                                            const std::vector<NodeID> & local_ids);
+
                 void extract_two_blocks(graph_access & G, 
                                         graph_access & extracted_block_lhs, 
                                         graph_access & extracted_block_rhs, 
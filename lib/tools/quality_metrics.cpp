@@ -24,6 +24,8 @@
 #include <cmath>
 
 #include "quality_metrics.h"
+#include "data_structure/parallel/algorithm.h"
+#include "data_structure/parallel/thread_pool.h"
 #include "data_structure/union_find.h"
 
 #include <unordered_map>
@@ -328,6 +330,11 @@ double quality_metrics::balance_edges(graph_access& G) {
 }
 
 EdgeWeight quality_metrics::objective(const PartitionConfig & config, graph_access & G, int* partition_map) {
+        if(config.parallel_combine_operators && !config.mh_penalty_for_unconnected) {
+                partition_metrics metrics = parallel_metrics(G, partition_map);
+                return config.mh_optimize_communication_volume ? metrics.max_communication_volume : metrics.edge_cut;
+        }
+
         if(config.mh_optimize_communication_volume) {
                 return max_communication_volume(G, partition_map);
         } else if(config.mh_penalty_for_unconnected) {
@@ -336,3 +343,106 @@ EdgeWeight quality_metrics::objective(const PartitionConfig & config, graph_acce
                 return edge_cut(G, partition_map);
         }
 }
+
+partition_metrics quality_metrics::parallel_metrics(graph_access & G) {
+        return compute_parallel_metrics(G, [&G](NodeID node) {
+                return G.getPartitionIndex(node);
+        });
+}
+
+partition_metrics quality_metrics::parallel_metrics(graph_access & G, int * partition_map) {
+        return compute_parallel_metrics(G, [partition_map](NodeID node) {
+                return (PartitionID) partition_map[node];
+        });
+}
+
+template <typename BlockFunctor>
+partition_metrics quality_metrics::compute_parallel_metrics(graph_access & G, BlockFunctor block_of) {
+        const PartitionID k = G.get_partition_count();
+
+        struct thread_accumulator {
+                EdgeWeight cut        = 0;
+                NodeID boundary_nodes = 0;
+                std::vector<NodeWeight> block_weights;
+                std::vector<EdgeWeight> block_volumes;
+                // incident[block] == node + 1 iff node has a neighbor in block
+                std::vector<NodeID> incident;
+                std::vector<uint64_t> block_pairs;
+        };
+        std::vector<thread_accumulator> accumulators(parallel::current_thread_pool().NumThreads() + 1);
+        for (thread_accumulator & acc : accumulators) {
+                acc.block_weights.resize(k, 0);
+                acc.block_volumes.resize(k, 0);
+                acc.incident.resize(k, 0);
+        }
+
+        parallel::parallel_for_index(NodeID(0), G.number_of_nodes(), [&](NodeID node, uint32_t thread_id) {
+                thread_accumulator & acc = accumulators[thread_id];
+                PartitionID block = block_of(node);
+                acc.block_weights[block] += G.getNodeWeight(node);
+
+                EdgeWeight incident_blocks = 0;
+                forall_out_edges(G, e, node) {
+                        PartitionID target_block = block_of(G.getEdgeTarget(e));
+                        if (target_block == block) {
+                                continue;
+                        }
+
+                        acc.cut += G.getEdgeWeight(e);
+                        if (acc.incident[target_block] != node + 1) {
+                                acc.incident[target_block] = node + 1;
+                                incident_blocks++;
+                                if (block < target_block) {
+                                        acc.block_pairs.push_back((uint64_t) block * k + target_block);
+                                }
+                        }
+                } endfor
+
+                acc.block_volumes[block] += incident_blocks;
+                if (incident_blocks > 0) {
+                        acc.boundary_nodes++;
+                }
+        });
+
+        // the block pairs of a thread are made unique by the thread itself
+        parallel::submit_for_all([&](uint32_t thread_id) {
+                std::vector<uint64_t> & pairs = accumulators[thread_id].block_pairs;
+                std::sort(pairs.begin(), pairs.end());
+                pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+        });
+
+        partition_metrics metrics;
+        metrics.block_weights.resize(k, 0);
+        std::vector<EdgeWeight> block_volumes(k, 0);
+        std::vector<uint64_t> block_pairs;
+        for (thread_accumulator & acc : accumulators) {
+                metrics.edge_cut       += acc.cut;
+                metrics.boundary_nodes += acc.boundary_nodes;
+                for (PartitionID block = 0; block < k; block++) {
+                        metrics.block_weights[block] += acc.block_weights[block];
+                        block_volumes[block]         += acc.block_volumes[block];
+                }
+                block_pairs.insert(block_pairs.end(), acc.block_pairs.begin(), acc.block_pairs.end());
+        }
+        metrics.edge_cut /= 2;
+
+        NodeWeight overall_weight = std::accumulate(metrics.block_weights.begin(), metrics.block_weights.end(), NodeWeight(0));
+        NodeWeight max_weight     = *std::max_element(metrics.block_weights.begin(), metrics.block_weights.end());
+        metrics.balance           = max_weight / ceil(overall_weight / (double) k);
+
+        metrics.total_communication_volume = std::accumulate(block_volumes.begin(), block_volumes.end(), EdgeWeight(0));
+        metrics.max_communication_volume   = *std::max_element(block_volumes.begin(), block_volumes.end());
+
+        std::sort(block_pairs.begin(), block_pairs.end());
+        block_pairs.erase(std::unique(block_pairs.begin(), block_pairs.end()), block_pairs.end());
+        metrics.quotient_graph_edges = block_pairs.size();
+
+        std::vector<PartitionID> block_degrees(k, 0);
+        for (uint64_t pair : block_pairs) {
+                block_degrees[pair / k]++;
+                block_degrees[pair % k]++;
+        }
+        metrics.max_block_connectivity = *std::max_element(block_degrees.begin(), block_degrees.end());
+
+        return metrics;
+}
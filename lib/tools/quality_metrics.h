@@ -24,9 +24,24 @@
 #ifndef QUALITY_METRICS_10HC2I5M
 #define QUALITY_METRICS_10HC2I5M
 
+#include <vector>
+
 #include "data_structure/graph_access.h"
 #include "partition_config.h"
 
+// all metrics that quality_metrics::parallel_metrics computes in one pass
+struct partition_metrics {
+        EdgeWeight edge_cut                   = 0;
+        std::vector<NodeWeight> block_weights;
+        double balance                        = 0;
+        NodeID boundary_nodes                 = 0;
+        EdgeWeight total_communication_volume = 0;
+        EdgeWeight max_communication_volume   = 0;
+        // number of block pairs that share a cut edge and the largest number of blocks a block shares cut edges with
+        EdgeID quotient_graph_edges           = 0;
+        PartitionID max_block_connectivity    = 0;
+};
+
 class quality_metrics {
 public:
         quality_metrics();
@@ -46,6 +61,15 @@ public:
         double balance(graph_access & G);
         double balance_edges(graph_access & G);
         double balance_separator(graph_access & G);
+
+        // computes all metrics with the thread pool in a single pass over the graph, so it must not be
+        // called from a task of the thread pool. partition_map replaces the partition of G
+        partition_metrics parallel_metrics(graph_access & G);
+        partition_metrics parallel_metrics(graph_access & G, int * partition_map);
+
+private:
+        template <typename BlockFunctor>
+        partition_metrics compute_parallel_metrics(graph_access & G, BlockFunctor block_of);
 };
 
 #endif /* end of include guard: QUALITY_METRICS_10HC2I5M */
@@ -0,0 +1,33 @@
+#!/bin/bash
+# Runs the evolutionary partitioner with crossovers only on the presets which coarsen with the parallel
+# local max matching, so every combine contracts a partitioned graph with that matching.
+# Reports per preset the total time and the resulting cut.
+#
+# usage: ./misc/benchmarks/combine_local_max.sh <graph> [k] [num_threads] [time_limit] [extra kaffpaE_threads options]
+# Set KAFFPAE to use a binary other than ./deploy/kaffpaE_threads.
+
+if [ "$#" -lt 1 ]; then
+        echo "usage: $0 <graph> [k] [num_threads] [time_limit] [extra kaffpaE_threads options]"
+        exit 1
+fi
+
+graph=$1
+k=${2:-16}
+num_threads=${3:-8}
+time_limit=${4:-30}
+shift $(( $# < 4 ? $# : 4 ))
+kaffpaE=${KAFFPAE:-./deploy/kaffpaE_threads}
+
+printf "preconfiguration\ttotal time\tcut\n"
+for preconfiguration in ecosocialmultitry_parallel ecosocialmultitry_parallel_fast; do
+        log=$($kaffpaE "$graph" --k=$k --num_threads=$num_threads --preconfiguration=$preconfiguration \
+                --time_limit=$time_limit --mh_flip_coin=0 "$@")
+        if [ "$?" -ne "0" ]; then
+                echo "kaffpaE_threads failed for $preconfiguration. exiting."
+                exit 1
+        fi
+
+        total=$(echo "$log" | grep "^time spent for partitioning" | awk '{print $NF}')
+        cut=$(echo "$log" | grep "^cut" | awk '{print $NF}')
+        printf "%s\t%s\t%s\n" "$preconfiguration" "$total" "$cut"
+done
@@ -0,0 +1,34 @@
+#!/bin/bash
+# Sweeps the number of blocks k from 2 to 65536 and reports the total partitioning time,
+# the time spent in parallel multitry kway refinement and the resulting cut.
+#
+# usage: ./misc/benchmarks/large_k_sweep.sh <graph> [num_threads] [preconfiguration] [extra kaffpa options]
+# The graph should have more than 65536 vertices. Set KAFFPA to use a binary other than ./deploy/kaffpa.
+
+if [ "$#" -lt 1 ]; then
+        echo "usage: $0 <graph> [num_threads] [preconfiguration] [extra kaffpa options]"
+        exit 1
+fi
+
+graph=$1
+num_threads=${2:-8}
+preconfiguration=${3:-fastsocialmultitry_parallel}
+shift $(( $# < 3 ? $# : 3 ))
+kaffpa=${KAFFPA:-./deploy/kaffpa}
+
+printf "k\ttotal time\trefinement time\tcut\n"
+k=2
+while [ "$k" -le 65536 ]; do
+        log=$($kaffpa "$graph" --k=$k --num_threads=$num_threads --preconfiguration=$preconfiguration "$@")
+        if [ "$?" -ne "0" ]; then
+                echo "kaffpa failed for k = $k. exiting."
+                exit 1
+        fi
+
+        total=$(echo "$log" | grep "^time spent for partitioning" | awk '{print $NF}')
+        refinement=$(echo "$log" | grep "^>> Refinement" | awk -F'\t' '{s += $2} END {print s + 0}')
+        cut=$(echo "$log" | grep "^cut" | awk '{print $NF}')
+        printf "%d\t%s\t%s\t%s\n" "$k" "$total" "$refinement" "$cut"
+
+        k=$(( k * 2 ))
+done
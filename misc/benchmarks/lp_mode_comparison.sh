@@ -0,0 +1,35 @@
+#!/bin/bash
+# Compares the round based (queue) and the asynchronous (async) parallel label propagation refinement.
+# Reports per mode the summed time of the lp iterations, the number of performed rounds
+# (for async the number of vertex visits divided by the number of vertices) and the resulting cut.
+#
+# usage: ./misc/benchmarks/lp_mode_comparison.sh <graph> [k] [num_threads] [preconfiguration] [extra kaffpa options]
+# Set KAFFPA to use a binary other than ./deploy/kaffpa.
+
+if [ "$#" -lt 1 ]; then
+        echo "usage: $0 <graph> [k] [num_threads] [preconfiguration] [extra kaffpa options]"
+        exit 1
+fi
+
+graph=$1
+k=${2:-16}
+num_threads=${3:-8}
+preconfiguration=${4:-fastsocialmultitry_parallel}
+shift $(( $# < 4 ? $# : 4 ))
+kaffpa=${KAFFPA:-./deploy/kaffpa}
+
+printf "mode\tlp time\tlp rounds\ttotal time\tcut\n"
+for mode in queue async; do
+        log=$($kaffpa "$graph" --k=$k --num_threads=$num_threads --preconfiguration=$preconfiguration \
+                --parallel_lp_type=$mode "$@")
+        if [ "$?" -ne "0" ]; then
+                echo "kaffpa failed for mode $mode. exiting."
+                exit 1
+        fi
+
+        lp_time=$(echo "$log" | grep "^Uncoarsening: Parallel lp: iterations" | awk -F'\t' '{s += $2} END {print s + 0}')
+        rounds=$(echo "$log" | grep "^Uncoarsening: Parallel lp: rounds" | awk -F'\t' '{s += $2} END {print s + 0}')
+        total=$(echo "$log" | grep "^time spent for partitioning" | awk '{print $NF}')
+        cut=$(echo "$log" | grep "^cut" | awk '{print $NF}')
+        printf "%s\t%s\t%s\t%s\t%s\n" "$mode" "$lp_time" "$rounds" "$total" "$cut"
+done
@@ -22,6 +22,7 @@
 
 #include <iostream>
 #include <sstream>
+#include <thread>
 
 #include "kaHIP_interface.h"
 
@@ -47,11 +48,57 @@ int main(int argn, char **argv) {
 
         //void kaffpa(int* n, int* vwgt, int* xadj, 
                    //int* adjcwgt, int* adjncy, int* nparts, 
-                   //double* imbalance,  bool suppress_output, int seed, int mode, 
+                   //double* imbalance,  bool suppress_output, int seed, int mode, uint32_t num_threads,
                    //int* edgecut, int* part);
 
-        kaffpa(&n, vwgt, xadj, adjcwgt, adjncy, &nparts, &imbalance, false, 0, ECO, & edge_cut, part);
+        kaffpa(&n, vwgt, xadj, adjcwgt, adjncy, &nparts, &imbalance, false, 0, ECO, 1, & edge_cut, part);
 
         std::cout <<  "edge cut " <<  edge_cut  << std::endl;
-                
+
+        // one coarsening for two and three blocks, the partition for nparts_batch[i] starts at part_batch + i*n
+        int nparts_batch[2]  = {2, 3};
+        int edge_cut_batch[2];
+        int* part_batch      = new int[2*n];
+        kaffpa_batch(&n, vwgt, xadj, adjcwgt, adjncy, nparts_batch, 2, &imbalance, true, 0, ECO, 1, edge_cut_batch, part_batch);
+
+        for( int i = 0; i < 2; i++) {
+                std::cout <<  "batch k " <<  nparts_batch[i] <<  " edge cut " <<  edge_cut_batch[i]  << std::endl;
+        }
+
+        // two sessions partition the graph at the same time, each one with its own threads
+        kahip_graph_view graph;
+        graph.n       = n;
+        graph.xadj    = xadj;
+        graph.adjncy  = adjncy;
+        graph.vwgt    = NULL;
+        graph.adjcwgt = NULL;
+
+        kahip_session* sessions[2];
+        int session_edge_cut[2];
+        int* session_part[2];
+        std::thread threads[2];
+        for( int i = 0; i < 2; i++) {
+                sessions[i]     = kahip_session_create(2, FASTSOCIAL_PARALLEL, true);
+                session_part[i] = new int[n];
+                threads[i] = std::thread([&, i]() {
+                        kahip_params params;
+                        params.nparts    = 2;
+                        params.imbalance = 0.03;
+                        params.seed      = i;
+                        params.objective = OBJECTIVE_CUT;
+
+                        // later calls of a session reuse its threads and graph buffers
+                        for( int round = 0; round < 3; round++) {
+                                kahip_partition(sessions[i], &graph, &params, &session_edge_cut[i], session_part[i]);
+                        }
+                });
+        }
+
+        for( int i = 0; i < 2; i++) {
+                threads[i].join();
+                std::cout <<  "session " <<  i <<  " edge cut " <<  session_edge_cut[i]  << std::endl;
+                kahip_session_destroy(sessions[i]);
+                delete[] session_part[i];
+        }
+        delete[] part_batch;
 }